@@ -0,0 +1,183 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <regex>
+#include <string>
+
+namespace bench
+{
+namespace
+{
+std::vector<std::unique_ptr<Benchmark>>& registry()
+{
+    static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+    return benchmarks;
+}
+
+struct Options
+{
+    std::string filter = ".*";
+    double min_time = 0.2;
+    std::size_t max_range = static_cast<std::size_t>(-1);
+};
+
+bool parse_flag(const char* arg, const char* flag, std::string& value)
+{
+    std::string prefix = std::string("--") + flag + "=";
+    if (std::string(arg).rfind(prefix, 0) != 0) return false;
+    value = arg + prefix.size();
+    return true;
+}
+
+Options parse_options(int argc, char** argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string value;
+        if (parse_flag(argv[i], "filter", value))
+            options.filter = value;
+        else if (parse_flag(argv[i], "min-time", value))
+            options.min_time = std::strtod(value.c_str(), nullptr);
+        else if (parse_flag(argv[i], "max-range", value))
+            options.max_range = std::strtoull(value.c_str(), nullptr, 10);
+        else
+            std::fprintf(stderr, "unknown argument: %s\n", argv[i]);
+    }
+    return options;
+}
+
+std::string format_rate(double items_per_second)
+{
+    const char* suffixes[] = {"", "k", "M", "G", "T"};
+    int suffix = 0;
+    while (items_per_second >= 1000.0 && suffix < 4)
+    {
+        items_per_second /= 1000.0;
+        ++suffix;
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.3g%s/s", items_per_second, suffixes[suffix]);
+    return buffer;
+}
+}  // namespace
+
+State::State(std::size_t range, std::size_t iterations)
+    : range_(range), iterations_(iterations), items_processed_(0), running_(false), elapsed_(0)
+{
+}
+
+State::iterator State::begin()
+{
+    resume_timing();
+    return iterator(this, iterations_);
+}
+
+State::iterator State::end() { return iterator(this, 0); }
+
+std::size_t State::range() const noexcept { return range_; }
+
+std::size_t State::iterations() const noexcept { return iterations_; }
+
+void State::pause_timing()
+{
+    if (!running_) return;
+    elapsed_ += clock::now() - start_;
+    running_ = false;
+}
+
+void State::resume_timing()
+{
+    if (running_) return;
+    start_ = clock::now();
+    running_ = true;
+}
+
+void State::finish() { pause_timing(); }
+
+void State::set_items_processed(std::size_t items) noexcept { items_processed_ = items; }
+
+std::size_t State::items_processed() const noexcept { return items_processed_; }
+
+double State::elapsed_seconds() const noexcept { return std::chrono::duration<double>(elapsed_).count(); }
+
+Benchmark::Benchmark(std::string name, Function function) : name_(std::move(name)), function_(std::move(function)) {}
+
+Benchmark* Benchmark::range(std::size_t range_lo, std::size_t range_hi, std::size_t multiplier)
+{
+    for (std::size_t value = range_lo; value <= range_hi; value *= multiplier)
+    {
+        args_.push_back(value);
+        if (value > range_hi / multiplier) break;
+    }
+    return this;
+}
+
+Benchmark* Benchmark::arg(std::size_t value)
+{
+    args_.push_back(value);
+    return this;
+}
+
+const std::string& Benchmark::name() const noexcept { return name_; }
+
+const std::vector<std::size_t>& Benchmark::args() const noexcept { return args_; }
+
+void Benchmark::run(State& state) const { function_(state); }
+
+Benchmark* register_benchmark(const std::string& name, Benchmark::Function function)
+{
+    registry().push_back(std::make_unique<Benchmark>(name, std::move(function)));
+    return registry().back().get();
+}
+
+int run_benchmarks(int argc, char** argv)
+{
+    Options options = parse_options(argc, argv);
+    std::regex filter(options.filter);
+
+    std::printf("%-56s %15s %12s %14s\n", "Benchmark", "Time", "Iterations", "Throughput");
+    std::printf("%s\n", std::string(100, '-').c_str());
+
+    for (const auto& benchmark : registry())
+    {
+        std::vector<std::size_t> args = benchmark->args();
+        if (args.empty()) args.push_back(0);
+
+        for (std::size_t arg : args)
+        {
+            if (arg > options.max_range) continue;
+            std::string name = benchmark->name() + "/" + std::to_string(arg);
+            if (!std::regex_search(name, filter)) continue;
+
+            std::size_t iterations = 1;
+            while (true)
+            {
+                State state(arg, iterations);
+                benchmark->run(state);
+                double elapsed = state.elapsed_seconds();
+
+                if (elapsed >= options.min_time || iterations >= 1'000'000'000)
+                {
+                    double per_iteration = elapsed / static_cast<double>(iterations) * 1e9;
+                    std::string rate = state.items_processed()
+                                           ? format_rate(static_cast<double>(state.items_processed()) / elapsed)
+                                           : std::string();
+                    std::printf("%-56s %12.0f ns %12zu %14s\n", name.c_str(), per_iteration, iterations, rate.c_str());
+                    std::fflush(stdout);
+                    break;
+                }
+
+                // grow towards the target time like Google Benchmark: predict, overshoot a little, cap at 10x
+                double multiplier = elapsed > 0.0 ? options.min_time * 1.4 / elapsed : 10.0;
+                multiplier = std::clamp(multiplier, 2.0, 10.0);
+                iterations = static_cast<std::size_t>(static_cast<double>(iterations) * multiplier);
+            }
+        }
+    }
+    return 0;
+}
+}  // namespace bench
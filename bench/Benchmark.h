@@ -0,0 +1,135 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+// Minimal Google-Benchmark-style harness:
+//
+//     static void BM_push_back(bench::State& state)
+//     {
+//         for (auto _ : state) { ... state.range() ... }
+//         state.set_items_processed(state.iterations() * state.range());
+//     }
+//     BENCHMARK(BM_push_back)->range(100, 10'000'000);
+//
+// Every registered benchmark is run once per argument, with the iteration
+// count grown until the timed region takes at least --min-time seconds.
+namespace bench
+{
+class State
+{
+   public:
+    struct [[gnu::unused]] Value
+    {
+    };
+
+    class iterator
+    {
+       private:
+        State* state_;
+        std::size_t remaining_;
+
+       public:
+        iterator(State* state, std::size_t remaining) : state_(state), remaining_(remaining) {}
+
+        Value operator*() const { return Value(); }
+        iterator& operator++()
+        {
+            --remaining_;
+            return *this;
+        }
+        bool operator!=(const iterator&)
+        {
+            if (remaining_ != 0) return true;
+            state_->finish();
+            return false;
+        }
+    };
+
+    State(std::size_t range, std::size_t iterations);
+
+    iterator begin();
+    iterator end();
+
+    std::size_t range() const noexcept;
+    std::size_t iterations() const noexcept;
+
+    // exclude per-iteration setup (building inputs, resetting containers) from the measurement
+    void pause_timing();
+    void resume_timing();
+
+    void set_items_processed(std::size_t items) noexcept;
+    std::size_t items_processed() const noexcept;
+
+    double elapsed_seconds() const noexcept;
+
+   private:
+    using clock = std::chrono::steady_clock;
+
+    void finish();
+
+    std::size_t range_;
+    std::size_t iterations_;
+    std::size_t items_processed_;
+    bool running_;
+    clock::time_point start_;
+    clock::duration elapsed_;
+};
+
+class Benchmark
+{
+   public:
+    using Function = std::function<void(State&)>;
+
+    Benchmark(std::string name, Function function);
+
+    // adds range_lo, range_lo * multiplier, ... up to and including range_hi
+    Benchmark* range(std::size_t range_lo, std::size_t range_hi, std::size_t multiplier = 10);
+    Benchmark* arg(std::size_t value);
+
+    const std::string& name() const noexcept;
+    const std::vector<std::size_t>& args() const noexcept;
+    void run(State& state) const;
+
+   private:
+    std::string name_;
+    Function function_;
+    std::vector<std::size_t> args_;
+};
+
+Benchmark* register_benchmark(const std::string& name, Benchmark::Function function);
+
+// parses --filter=<regex>, --min-time=<seconds> and --max-range=<n>, runs every matching benchmark
+int run_benchmarks(int argc, char** argv);
+
+template <typename T>
+inline void do_not_optimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobber_memory()
+{
+    asm volatile("" : : : "memory");
+}
+
+// deterministic input so std:: baselines and our containers see the same keys
+inline std::vector<int> random_ints(std::size_t count, int max_value = 1 << 30, unsigned seed = 42)
+{
+    std::mt19937 engine(seed);
+    std::uniform_int_distribution<int> distribution(0, max_value);
+    std::vector<int> values(count);
+    for (auto& value : values) value = distribution(engine);
+    return values;
+}
+}  // namespace bench
+
+#define BENCH_CONCAT_IMPL(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_IMPL(a, b)
+#define BENCHMARK(function)                                                                \
+    [[maybe_unused]] static ::bench::Benchmark* BENCH_CONCAT(bench_registration_, __LINE__) = \
+        ::bench::register_benchmark(#function, function)
@@ -0,0 +1,99 @@
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../include/ConcurrentForwardList.h"
+#include "../include/ForwardList.h"
+#include "../include/NodePool.h"
+#include "Benchmark.h"
+
+// items pushed per iteration, split evenly between the producers
+static constexpr std::size_t handoff_items = 1 << 16;
+
+template <typename Alloc>
+struct LockFreeQueue
+{
+    ConcurrentForwardList<int, Alloc> list;
+    // reused across drains, so each take_all() is move-assigned into it
+    ForwardList<int, Alloc> batch;
+
+    void push(int value) { list.push_front(value); }
+
+    template <typename Consume>
+    void drain(Consume&& consume)
+    {
+        batch = list.take_all();
+        for (int value : batch) consume(value);
+    }
+};
+
+// the baseline: a ForwardList behind a mutex, drained under the lock
+struct MutexQueue
+{
+    std::mutex mutex;
+    ForwardList<int> list;
+
+    void push(int value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        list.push_front(value);
+    }
+
+    template <typename Consume>
+    void drain(Consume&& consume)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        while (!list.empty())
+        {
+            consume(list.front());
+            list.pop_front();
+        }
+    }
+};
+
+// state.range() producer threads push handoff_items between them while the benchmark thread
+// drains the queue until it has received every item
+template <typename Queue>
+static void handoff(bench::State& state)
+{
+    std::size_t producers = state.range();
+    std::size_t share = handoff_items / producers;
+    for (auto _ : state)
+    {
+        Queue queue;
+        std::vector<std::thread> threads;
+        for (std::size_t p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&queue, share] {
+                for (std::size_t i = 0; i < share; ++i) queue.push(static_cast<int>(i));
+            });
+        }
+
+        std::size_t received = 0;
+        long long sum = 0;
+        while (received < share * producers)
+        {
+            std::size_t before = received;
+            queue.drain([&](int value) {
+                sum += value;
+                ++received;
+            });
+            if (received == before) std::this_thread::yield();
+        }
+        for (std::thread& thread : threads) thread.join();
+        bench::do_not_optimize(sum);
+    }
+    state.set_items_processed(state.iterations() * share * producers);
+}
+
+static void BM_ConcurrentForwardList_handoff(bench::State& state) { handoff<LockFreeQueue<std::allocator<int>>>(state); }
+BENCHMARK(BM_ConcurrentForwardList_handoff)->range(1, 64, 2);
+
+static void BM_ConcurrentForwardList_handoff_pooled(bench::State& state)
+{
+    handoff<LockFreeQueue<PoolAllocator<int>>>(state);
+}
+BENCHMARK(BM_ConcurrentForwardList_handoff_pooled)->range(1, 64, 2);
+
+static void BM_ForwardList_mutex_handoff(bench::State& state) { handoff<MutexQueue>(state); }
+BENCHMARK(BM_ForwardList_mutex_handoff)->range(1, 64, 2);
@@ -0,0 +1,75 @@
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "../include/ConcurrentStack.h"
+#include "../include/ForwardList.h"
+#include "../include/NodePool.h"
+#include "Benchmark.h"
+
+// push/pop pairs per iteration, split evenly between the threads
+static constexpr std::size_t free_list_operations = 1 << 16;
+
+// the baseline: a ForwardList stack behind a mutex
+struct MutexStack
+{
+    std::mutex mutex;
+    ForwardList<int> list;
+
+    void push(int value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        list.push_front(value);
+    }
+
+    std::optional<int> pop()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (list.empty()) return std::nullopt;
+        int value = list.front();
+        list.pop_front();
+        return value;
+    }
+};
+
+// free-list traffic: state.range() threads each release an object and take one back,
+// against a stack pre-filled with 1024 entries
+template <typename Stack>
+static void free_list_churn(bench::State& state)
+{
+    std::size_t threads = state.range();
+    std::size_t share = free_list_operations / threads;
+    Stack stack;
+    for (int i = 0; i < 1024; ++i) stack.push(i);
+    for (auto _ : state)
+    {
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&stack, share] {
+                long long sum = 0;
+                for (std::size_t i = 0; i < share; ++i)
+                {
+                    stack.push(static_cast<int>(i));
+                    if (std::optional<int> value = stack.pop()) sum += *value;
+                }
+                bench::do_not_optimize(sum);
+            });
+        }
+        for (std::thread& worker : workers) worker.join();
+    }
+    state.set_items_processed(state.iterations() * share * threads);
+}
+
+static void BM_ConcurrentStack_free_list(bench::State& state) { free_list_churn<ConcurrentStack<int>>(state); }
+BENCHMARK(BM_ConcurrentStack_free_list)->range(1, 64, 2);
+
+static void BM_ConcurrentStack_free_list_pooled(bench::State& state)
+{
+    free_list_churn<ConcurrentStack<int, PoolAllocator<int>>>(state);
+}
+BENCHMARK(BM_ConcurrentStack_free_list_pooled)->range(1, 64, 2);
+
+static void BM_ForwardList_mutex_free_list(bench::State& state) { free_list_churn<MutexStack>(state); }
+BENCHMARK(BM_ForwardList_mutex_free_list)->range(1, 64, 2);
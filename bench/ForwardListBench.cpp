@@ -0,0 +1,147 @@
+#include <deque>
+#include <forward_list>
+#include <list>
+#include <vector>
+
+#include "../include/ForwardList.h"
+#include "../include/NodePool.h"
+#include "Benchmark.h"
+
+static void BM_ForwardList_push_front(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        ForwardList<int> list;
+        for (std::size_t i = 0; i < state.range(); ++i) list.push_front(static_cast<int>(i));
+        bench::do_not_optimize(list.front());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_ForwardList_push_front)->range(100, 10'000'000);
+
+static void BM_std_forward_list_push_front(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        std::forward_list<int> list;
+        for (std::size_t i = 0; i < state.range(); ++i) list.push_front(static_cast<int>(i));
+        bench::do_not_optimize(list.front());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_forward_list_push_front)->range(100, 10'000'000);
+
+static void BM_ForwardList_push_front_pooled(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        ForwardList<int, PoolAllocator<int>> list;
+        for (std::size_t i = 0; i < state.range(); ++i) list.push_front(static_cast<int>(i));
+        bench::do_not_optimize(list.front());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_ForwardList_push_front_pooled)->range(100, 10'000'000);
+
+// stack traffic with a deep stack: each push_front is paired with a pop_front
+template <typename Stack>
+static void stack_churn(bench::State& state)
+{
+    Stack stack;
+    for (int i = 0; i < 1024; ++i) stack.push_front(i);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < state.range(); ++i)
+        {
+            stack.push_front(static_cast<int>(i));
+            stack.pop_front();
+        }
+        bench::do_not_optimize(stack.front());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+
+static void BM_ForwardList_churn(bench::State& state) { stack_churn<ForwardList<int>>(state); }
+BENCHMARK(BM_ForwardList_churn)->range(100, 1'000'000);
+
+static void BM_ForwardList_churn_pooled(bench::State& state) { stack_churn<ForwardList<int, PoolAllocator<int>>>(state); }
+BENCHMARK(BM_ForwardList_churn_pooled)->range(100, 1'000'000);
+
+static void BM_std_forward_list_churn(bench::State& state) { stack_churn<std::forward_list<int>>(state); }
+BENCHMARK(BM_std_forward_list_churn)->range(100, 1'000'000);
+
+static void BM_ForwardList_sort(bench::State& state)
+{
+    std::vector<int> input = bench::random_ints(state.range());
+    for (auto _ : state)
+    {
+        state.pause_timing();
+        ForwardList<int> list(input.begin(), input.end());
+        state.resume_timing();
+        list.sort();
+        bench::do_not_optimize(list.front());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_ForwardList_sort)->range(100, 10'000'000);
+
+static void BM_std_forward_list_sort(bench::State& state)
+{
+    std::vector<int> input = bench::random_ints(state.range());
+    for (auto _ : state)
+    {
+        state.pause_timing();
+        std::forward_list<int> list(input.begin(), input.end());
+        state.resume_timing();
+        list.sort();
+        bench::do_not_optimize(list.front());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_forward_list_sort)->range(100, 10'000'000);
+
+static void BM_ForwardList_reverse(bench::State& state)
+{
+    std::vector<int> input = bench::random_ints(state.range());
+    ForwardList<int> list(input.begin(), input.end());
+    for (auto _ : state)
+    {
+        list.reverse();
+        bench::do_not_optimize(list.front());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_ForwardList_reverse)->range(100, 1'000'000);
+
+// FIFO traffic with a long queue: each push_back is paired with a pop_front
+template <typename Queue>
+static void queue_churn(bench::State& state)
+{
+    Queue queue;
+    for (int i = 0; i < 1024; ++i) queue.push_back(i);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < state.range(); ++i)
+        {
+            queue.push_back(static_cast<int>(i));
+            queue.pop_front();
+        }
+        bench::do_not_optimize(queue.front());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+
+static void BM_ForwardList_queue(bench::State& state) { queue_churn<ForwardList<int, std::allocator<int>, true>>(state); }
+BENCHMARK(BM_ForwardList_queue)->range(100, 1'000'000);
+
+static void BM_ForwardList_queue_pooled(bench::State& state)
+{
+    queue_churn<ForwardList<int, PoolAllocator<int>, true>>(state);
+}
+BENCHMARK(BM_ForwardList_queue_pooled)->range(100, 1'000'000);
+
+static void BM_std_list_queue(bench::State& state) { queue_churn<std::list<int>>(state); }
+BENCHMARK(BM_std_list_queue)->range(100, 1'000'000);
+
+static void BM_std_deque_queue(bench::State& state) { queue_churn<std::deque<int>>(state); }
+BENCHMARK(BM_std_deque_queue)->range(100, 1'000'000);
@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <vector>
+
+#include "../include/Heap.h"
+#include "Benchmark.h"
+
+static void BM_makeHeap(bench::State& state)
+{
+    std::vector<int> input = bench::random_ints(state.range());
+    std::vector<int> heap;
+    for (auto _ : state)
+    {
+        state.pause_timing();
+        heap = input;
+        state.resume_timing();
+        makeHeap(heap.begin(), heap.end());
+        bench::do_not_optimize(heap.front());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_makeHeap)->range(100, 10'000'000);
+
+static void BM_std_make_heap(bench::State& state)
+{
+    std::vector<int> input = bench::random_ints(state.range());
+    std::vector<int> heap;
+    for (auto _ : state)
+    {
+        state.pause_timing();
+        heap = input;
+        state.resume_timing();
+        std::make_heap(heap.begin(), heap.end());
+        bench::do_not_optimize(heap.front());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_make_heap)->range(100, 10'000'000);
+
+// pushes every element, then pops them all (heap sort)
+static void BM_pushHeap_popHeap(bench::State& state)
+{
+    std::vector<int> input = bench::random_ints(state.range());
+    std::vector<int> heap(input.size());
+    for (auto _ : state)
+    {
+        state.pause_timing();
+        heap = input;
+        state.resume_timing();
+        for (auto it = heap.begin() + 1; it <= heap.end(); ++it) pushHeap(heap.begin(), it);
+        for (auto it = heap.end(); it != heap.begin(); --it) popHeap(heap.begin(), it);
+        bench::do_not_optimize(heap.front());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_pushHeap_popHeap)->range(100, 10'000'000);
+
+static void BM_std_push_heap_pop_heap(bench::State& state)
+{
+    std::vector<int> input = bench::random_ints(state.range());
+    std::vector<int> heap(input.size());
+    for (auto _ : state)
+    {
+        state.pause_timing();
+        heap = input;
+        state.resume_timing();
+        for (auto it = heap.begin() + 1; it <= heap.end(); ++it) std::push_heap(heap.begin(), it);
+        for (auto it = heap.end(); it != heap.begin(); --it) std::pop_heap(heap.begin(), it);
+        bench::do_not_optimize(heap.front());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_push_heap_pop_heap)->range(100, 10'000'000);
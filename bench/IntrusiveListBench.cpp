@@ -0,0 +1,91 @@
+#include <list>
+#include <vector>
+
+#include "../include/IntrusiveList.h"
+#include "../include/List.h"
+#include "Benchmark.h"
+
+// LRU touches: each access moves a random entry of a range-sized cache to the front
+static constexpr std::size_t accesses = 4096;
+
+struct IntrusiveEntry
+{
+    int key;
+    IntrusiveListHook lru;
+};
+
+static void BM_IntrusiveList_lru_touch(bench::State& state)
+{
+    std::vector<IntrusiveEntry> entries(state.range());
+    IntrusiveList<IntrusiveEntry, &IntrusiveEntry::lru> lru;
+    for (std::size_t i = 0; i < entries.size(); ++i)
+    {
+        entries[i].key = static_cast<int>(i);
+        lru.push_back(entries[i]);
+    }
+    std::vector<int> keys = bench::random_ints(accesses, static_cast<int>(state.range()) - 1);
+    for (auto _ : state)
+    {
+        for (int key : keys) lru.move_to_front(entries[key]);
+        bench::do_not_optimize(lru.front().key);
+    }
+    lru.clear();
+    state.set_items_processed(state.iterations() * accesses);
+}
+BENCHMARK(BM_IntrusiveList_lru_touch)->range(100, 1'000'000);
+
+// the non-intrusive way: a List of pointers, each entry remembering its position
+struct ListEntry
+{
+    int key;
+    List<ListEntry*>::iterator position;
+};
+
+static void BM_List_lru_touch(bench::State& state)
+{
+    std::vector<ListEntry> entries(state.range());
+    List<ListEntry*> lru;
+    for (std::size_t i = 0; i < entries.size(); ++i)
+    {
+        entries[i].key = static_cast<int>(i);
+        entries[i].position = lru.insert(lru.end(), &entries[i]);
+    }
+    std::vector<int> keys = bench::random_ints(accesses, static_cast<int>(state.range()) - 1);
+    for (auto _ : state)
+    {
+        for (int key : keys)
+        {
+            ListEntry& entry = entries[key];
+            lru.erase(entry.position);
+            entry.position = lru.insert(lru.begin(), &entry);
+        }
+        bench::do_not_optimize(lru.front()->key);
+    }
+    state.set_items_processed(state.iterations() * accesses);
+}
+BENCHMARK(BM_List_lru_touch)->range(100, 1'000'000);
+
+struct StdEntry
+{
+    int key;
+    std::list<StdEntry*>::iterator position;
+};
+
+static void BM_std_list_lru_touch(bench::State& state)
+{
+    std::vector<StdEntry> entries(state.range());
+    std::list<StdEntry*> lru;
+    for (std::size_t i = 0; i < entries.size(); ++i)
+    {
+        entries[i].key = static_cast<int>(i);
+        entries[i].position = lru.insert(lru.end(), &entries[i]);
+    }
+    std::vector<int> keys = bench::random_ints(accesses, static_cast<int>(state.range()) - 1);
+    for (auto _ : state)
+    {
+        for (int key : keys) lru.splice(lru.begin(), lru, entries[key].position);
+        bench::do_not_optimize(lru.front()->key);
+    }
+    state.set_items_processed(state.iterations() * accesses);
+}
+BENCHMARK(BM_std_list_lru_touch)->range(100, 1'000'000);
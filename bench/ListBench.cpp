@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "../include/List.h"
+#include "../include/NodePool.h"
+#include "Benchmark.h"
+
+static void BM_List_push_back(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        List<int> list;
+        for (std::size_t i = 0; i < state.range(); ++i) list.push_back(static_cast<int>(i));
+        bench::do_not_optimize(list.back());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_List_push_back)->range(100, 10'000'000);
+
+static void BM_std_list_push_back(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        std::list<int> list;
+        for (std::size_t i = 0; i < state.range(); ++i) list.push_back(static_cast<int>(i));
+        bench::do_not_optimize(list.back());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_list_push_back)->range(100, 10'000'000);
+
+// handing a list of message buffers on: a copy duplicates every string, a move relinks two nodes
+static void BM_List_copy_strings(bench::State& state)
+{
+    List<std::string> list;
+    for (std::size_t i = 0; i < state.range(); ++i) list.emplace_back(256, 'm');
+    for (auto _ : state)
+    {
+        List<std::string> copy(list);
+        bench::do_not_optimize(copy.back());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_List_copy_strings)->range(100, 100'000);
+
+static void BM_List_move_strings(bench::State& state)
+{
+    List<std::string> list;
+    for (std::size_t i = 0; i < state.range(); ++i) list.emplace_back(256, 'm');
+    for (auto _ : state)
+    {
+        List<std::string> moved(std::move(list));
+        bench::do_not_optimize(moved.back());
+        list = std::move(moved);
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_List_move_strings)->range(100, 100'000);
+
+static void BM_List_iterate(bench::State& state)
+{
+    List<int> list;
+    for (std::size_t i = 0; i < state.range(); ++i) list.push_back(static_cast<int>(i));
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        for (int value : list) sum += value;
+        bench::do_not_optimize(sum);
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_List_iterate)->range(100, 1'000'000);
+
+static void BM_std_list_iterate(bench::State& state)
+{
+    std::list<int> list;
+    for (std::size_t i = 0; i < state.range(); ++i) list.push_back(static_cast<int>(i));
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        for (int value : list) sum += value;
+        bench::do_not_optimize(sum);
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_list_iterate)->range(100, 1'000'000);
+
+static void BM_List_push_back_pooled(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        List<int, PoolAllocator<int>> list;
+        for (std::size_t i = 0; i < state.range(); ++i) list.push_back(static_cast<int>(i));
+        bench::do_not_optimize(list.back());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_List_push_back_pooled)->range(100, 10'000'000);
+
+// queue traffic: every push_back is paired with a pop_front, so nodes are freed and reused
+template <typename Queue>
+static void queue_churn(bench::State& state)
+{
+    constexpr int window = 1024;
+    Queue queue;
+    for (int i = 0; i < window; ++i) queue.push_back(i);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < state.range(); ++i)
+        {
+            queue.push_back(static_cast<int>(i));
+            queue.pop_front();
+        }
+        bench::do_not_optimize(queue.front());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+
+static void BM_List_churn(bench::State& state) { queue_churn<List<int>>(state); }
+BENCHMARK(BM_List_churn)->range(100, 1'000'000);
+
+static void BM_List_churn_pooled(bench::State& state) { queue_churn<List<int, PoolAllocator<int>>>(state); }
+BENCHMARK(BM_List_churn_pooled)->range(100, 1'000'000);
+
+static void BM_std_list_churn(bench::State& state) { queue_churn<std::list<int>>(state); }
+BENCHMARK(BM_std_list_churn)->range(100, 1'000'000);
+
+static void BM_List_sort(bench::State& state)
+{
+    std::vector<int> input = bench::random_ints(state.range());
+    for (auto _ : state)
+    {
+        state.pause_timing();
+        List<int> list(input.begin(), input.end());
+        state.resume_timing();
+        list.sort();
+        bench::do_not_optimize(list.front());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_List_sort)->range(100, 10'000'000);
+
+static void BM_std_list_sort(bench::State& state)
+{
+    std::vector<int> input = bench::random_ints(state.range());
+    for (auto _ : state)
+    {
+        state.pause_timing();
+        std::list<int> list(input.begin(), input.end());
+        state.resume_timing();
+        list.sort();
+        bench::do_not_optimize(list.front());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_list_sort)->range(100, 10'000'000);
+
+static void BM_List_merge(bench::State& state)
+{
+    std::vector<int> left = bench::random_ints(state.range(), 1 << 30, 1);
+    std::vector<int> right = bench::random_ints(state.range(), 1 << 30, 2);
+    std::sort(left.begin(), left.end());
+    std::sort(right.begin(), right.end());
+    for (auto _ : state)
+    {
+        state.pause_timing();
+        List<int> first(left.begin(), left.end());
+        List<int> second(right.begin(), right.end());
+        state.resume_timing();
+        first.merge(second);
+        bench::do_not_optimize(first.front());
+    }
+    state.set_items_processed(state.iterations() * state.range() * 2);
+}
+BENCHMARK(BM_List_merge)->range(100, 1'000'000);
+
+static void BM_std_list_merge(bench::State& state)
+{
+    std::vector<int> left = bench::random_ints(state.range(), 1 << 30, 1);
+    std::vector<int> right = bench::random_ints(state.range(), 1 << 30, 2);
+    std::sort(left.begin(), left.end());
+    std::sort(right.begin(), right.end());
+    for (auto _ : state)
+    {
+        state.pause_timing();
+        std::list<int> first(left.begin(), left.end());
+        std::list<int> second(right.begin(), right.end());
+        state.resume_timing();
+        first.merge(second);
+        bench::do_not_optimize(first.front());
+    }
+    state.set_items_processed(state.iterations() * state.range() * 2);
+}
+BENCHMARK(BM_std_list_merge)->range(100, 1'000'000);
+
+// splicing whole lists back and forth: constant time regardless of length
+static void BM_List_splice(bench::State& state)
+{
+    std::vector<int> input = bench::random_ints(state.range());
+    List<int> first(input.begin(), input.end());
+    List<int> second;
+    for (auto _ : state)
+    {
+        second.splice(second.end(), first);
+        first.splice(first.begin(), second);
+        bench::do_not_optimize(first.front());
+    }
+    state.set_items_processed(state.iterations() * 2);
+}
+BENCHMARK(BM_List_splice)->range(100, 1'000'000);
+
+static void BM_std_list_splice(bench::State& state)
+{
+    std::vector<int> input = bench::random_ints(state.range());
+    std::list<int> first(input.begin(), input.end());
+    std::list<int> second;
+    for (auto _ : state)
+    {
+        second.splice(second.end(), first);
+        first.splice(first.begin(), second);
+        bench::do_not_optimize(first.front());
+    }
+    state.set_items_processed(state.iterations() * 2);
+}
+BENCHMARK(BM_std_list_splice)->range(100, 1'000'000);
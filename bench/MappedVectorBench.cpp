@@ -0,0 +1,84 @@
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "../include/MappedVector.h"
+#include "../include/Vector.h"
+#include "Benchmark.h"
+
+namespace
+{
+struct Record
+{
+    long long id;
+    double value;
+};
+
+std::string bench_path()
+{
+    return (std::filesystem::temp_directory_path() / "mapped_vector_bench.bin").string();
+}
+}  // namespace
+
+static void BM_MappedVector_push_back(bench::State& state)
+{
+    std::string path = bench_path();
+    for (auto _ : state)
+    {
+        {
+            MappedVector<Record> vector(path);
+            vector.clear();
+            for (std::size_t i = 0; i < state.range(); ++i) vector.push_back({static_cast<long long>(i), 0.5});
+            bench::do_not_optimize(vector.data());
+        }
+        state.pause_timing();
+        std::filesystem::remove(path);
+        state.resume_timing();
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_MappedVector_push_back)->range(1'000, 10'000'000);
+
+// startup cost of getting a previous run's records back: reopening the file...
+static void BM_MappedVector_reopen(bench::State& state)
+{
+    std::string path = bench_path();
+    {
+        MappedVector<Record> vector(path);
+        vector.clear();
+        for (std::size_t i = 0; i < state.range(); ++i) vector.push_back({static_cast<long long>(i), 0.5});
+    }
+    for (auto _ : state)
+    {
+        MappedVector<Record> vector(path);
+        bench::do_not_optimize(vector.back());
+    }
+    std::filesystem::remove(path);
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_MappedVector_reopen)->range(1'000, 10'000'000);
+
+// ...versus reading a raw dump of them into a Vector
+static void BM_Vector_reload(bench::State& state)
+{
+    std::string path = bench_path();
+    {
+        std::vector<Record> records(state.range(), Record{1, 0.5});
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        std::fwrite(records.data(), sizeof(Record), records.size(), file);
+        std::fclose(file);
+    }
+    for (auto _ : state)
+    {
+        Vector<Record> vector;
+        vector.resize_uninitialized(state.range());
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        bench::do_not_optimize(std::fread(vector.data(), sizeof(Record), state.range(), file));
+        std::fclose(file);
+        bench::do_not_optimize(vector.back());
+    }
+    std::filesystem::remove(path);
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Vector_reload)->range(1'000, 10'000'000);
@@ -0,0 +1,70 @@
+#include <numeric>
+#include <utility>
+
+#include "../include/RationalNumber.h"
+#include "Benchmark.h"
+
+// operands stay small so repeated arithmetic never overflows long long
+static std::vector<RationalNumber<long long>> make_rationals(std::size_t count)
+{
+    std::vector<int> values = bench::random_ints(count * 2, 1000);
+    std::vector<RationalNumber<long long>> rationals;
+    rationals.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) rationals.emplace_back(values[2 * i] - 500, values[2 * i + 1] + 1);
+    return rationals;
+}
+
+static void BM_RationalNumber_arithmetic(bench::State& state)
+{
+    std::vector<RationalNumber<long long>> rationals = make_rationals(state.range() + 1);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < state.range(); ++i)
+        {
+            const auto& left = rationals[i];
+            const auto& right = rationals[i + 1];
+            bench::do_not_optimize(left + right);
+            bench::do_not_optimize(left - right);
+            bench::do_not_optimize(left * right);
+        }
+    }
+    state.set_items_processed(state.iterations() * state.range() * 3);
+}
+BENCHMARK(BM_RationalNumber_arithmetic)->range(100, 10'000'000);
+
+// baseline: the same normalised fraction arithmetic written directly on std::gcd/std::lcm
+static void BM_std_gcd_fraction_arithmetic(bench::State& state)
+{
+    using Fraction = std::pair<long long, long long>;
+    std::vector<int> values = bench::random_ints((state.range() + 1) * 2, 1000);
+    std::vector<Fraction> fractions;
+    for (std::size_t i = 0; i <= state.range(); ++i)
+    {
+        long long numerator = values[2 * i] - 500;
+        long long denominator = values[2 * i + 1] + 1;
+        long long divisor = std::gcd(numerator, denominator);
+        fractions.emplace_back(numerator / divisor, denominator / divisor);
+    }
+    auto normalise = [](long long numerator, long long denominator)
+    {
+        long long divisor = std::gcd(numerator, denominator);
+        return Fraction(numerator / divisor, denominator / divisor);
+    };
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < state.range(); ++i)
+        {
+            const auto& [ln, ld] = fractions[i];
+            const auto& [rn, rd] = fractions[i + 1];
+            long long common = std::lcm(ld, rd);
+            bench::do_not_optimize(normalise(ln * (common / ld) + rn * (common / rd), common));
+            bench::do_not_optimize(normalise(ln * (common / ld) - rn * (common / rd), common));
+            long long g1 = std::gcd(ln, rd);
+            long long g2 = std::gcd(ld, rn);
+            bench::do_not_optimize(normalise((ln / g1) * (rn / g2), (ld / g2) * (rd / g1)));
+        }
+    }
+    state.set_items_processed(state.iterations() * state.range() * 3);
+}
+BENCHMARK(BM_std_gcd_fraction_arithmetic)->range(100, 10'000'000);
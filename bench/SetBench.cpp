@@ -0,0 +1,375 @@
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <string>
+#include <string_view>
+
+#include "../include/NodePool.h"
+#include "../include/Set.h"
+#include "Benchmark.h"
+
+static void BM_Set_insert(bench::State& state)
+{
+    std::vector<int> keys = bench::random_ints(state.range());
+    for (auto _ : state)
+    {
+        Set<int> set;
+        for (int key : keys) set.insert(key);
+        bench::do_not_optimize(set.size());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Set_insert)->range(100, 10'000'000);
+
+static void BM_std_set_insert(bench::State& state)
+{
+    std::vector<int> keys = bench::random_ints(state.range());
+    for (auto _ : state)
+    {
+        std::set<int> set;
+        for (int key : keys) set.insert(key);
+        bench::do_not_optimize(set.size());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_set_insert)->range(100, 10'000'000);
+
+static void BM_Set_insert_pooled(bench::State& state)
+{
+    std::vector<int> keys = bench::random_ints(state.range());
+    for (auto _ : state)
+    {
+        Set<int, std::less<int>, PoolAllocator<int>> set;
+        for (int key : keys) set.insert(key);
+        bench::do_not_optimize(set.size());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Set_insert_pooled)->range(100, 10'000'000);
+
+// time-ordered IDs: every key is larger than all before it
+static void BM_Set_insert_sorted(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        Set<int> set;
+        for (std::size_t i = 0; i < state.range(); ++i) set.insert(static_cast<int>(i));
+        bench::do_not_optimize(set.size());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Set_insert_sorted)->range(100, 10'000'000);
+
+static void BM_Set_insert_sorted_hint(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        Set<int> set;
+        for (std::size_t i = 0; i < state.range(); ++i) set.insert(set.end(), static_cast<int>(i));
+        bench::do_not_optimize(set.size());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Set_insert_sorted_hint)->range(100, 10'000'000);
+
+static void BM_std_set_insert_sorted_hint(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        std::set<int> set;
+        for (std::size_t i = 0; i < state.range(); ++i) set.insert(set.end(), static_cast<int>(i));
+        bench::do_not_optimize(set.size());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_set_insert_sorted_hint)->range(100, 10'000'000);
+
+// rebuilding an index from a sorted snapshot
+static void BM_Set_from_sorted(bench::State& state)
+{
+    std::vector<int> keys = bench::random_ints(state.range());
+    std::sort(keys.begin(), keys.end());
+    for (auto _ : state)
+    {
+        Set<int> set = Set<int>::from_sorted(keys.begin(), keys.end());
+        bench::do_not_optimize(set.size());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Set_from_sorted)->range(100, 10'000'000);
+
+static void BM_Set_from_sorted_pooled(bench::State& state)
+{
+    std::vector<int> keys = bench::random_ints(state.range());
+    std::sort(keys.begin(), keys.end());
+    for (auto _ : state)
+    {
+        auto set = Set<int, std::less<int>, PoolAllocator<int>>::from_sorted(keys.begin(), keys.end());
+        bench::do_not_optimize(set.size());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Set_from_sorted_pooled)->range(100, 10'000'000);
+
+// a PoolAllocator that stays with its container: moving a set between pools must copy the keys
+template <typename T>
+class PinnedPoolAllocator : public PoolAllocator<T>
+{
+   public:
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+
+    using PoolAllocator<T>::PoolAllocator;
+
+    template <typename U>
+    PinnedPoolAllocator(const PinnedPoolAllocator<U>& other) noexcept : PoolAllocator<T>(other)
+    {
+    }
+};
+
+// move assignment across pools falls back to an O(n) rebuild from the source's ordered keys
+static void BM_Set_move_assign_other_pool(bench::State& state)
+{
+    using PinnedSet = Set<int, std::less<int>, PinnedPoolAllocator<int>>;
+    std::vector<int> keys = bench::random_ints(state.range());
+    std::sort(keys.begin(), keys.end());
+    NodePool source_pool;
+    NodePool target_pool;
+    PinnedSet target{PinnedPoolAllocator<int>(target_pool)};
+    for (auto _ : state)
+    {
+        state.pause_timing();
+        auto source = PinnedSet::from_sorted(keys.begin(), keys.end(), std::less<int>(),
+                                             PinnedPoolAllocator<int>(source_pool));
+        state.resume_timing();
+        target = std::move(source);
+        bench::do_not_optimize(target.size());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Set_move_assign_other_pool)->range(100, 1'000'000);
+
+static void BM_std_set_range_sorted(bench::State& state)
+{
+    std::vector<int> keys = bench::random_ints(state.range());
+    std::sort(keys.begin(), keys.end());
+    for (auto _ : state)
+    {
+        std::set<int> set(keys.begin(), keys.end());
+        bench::do_not_optimize(set.size());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_set_range_sorted)->range(100, 10'000'000);
+
+static void BM_Set_contains(bench::State& state)
+{
+    std::vector<int> keys = bench::random_ints(state.range());
+    std::vector<int> queries = bench::random_ints(state.range(), 1 << 30, 7);
+    Set<int> set;
+    for (int key : keys) set.insert(key);
+    for (auto _ : state)
+    {
+        std::size_t found = 0;
+        for (int query : queries) found += set.contains(query);
+        for (int key : keys) found += set.contains(key);
+        bench::do_not_optimize(found);
+    }
+    state.set_items_processed(state.iterations() * state.range() * 2);
+}
+BENCHMARK(BM_Set_contains)->range(100, 10'000'000);
+
+static void BM_std_set_contains(bench::State& state)
+{
+    std::vector<int> keys = bench::random_ints(state.range());
+    std::vector<int> queries = bench::random_ints(state.range(), 1 << 30, 7);
+    std::set<int> set(keys.begin(), keys.end());
+    for (auto _ : state)
+    {
+        std::size_t found = 0;
+        for (int query : queries) found += set.contains(query);
+        for (int key : keys) found += set.contains(key);
+        bench::do_not_optimize(found);
+    }
+    state.set_items_processed(state.iterations() * state.range() * 2);
+}
+BENCHMARK(BM_std_set_contains)->range(100, 10'000'000);
+
+static void BM_Set_erase(bench::State& state)
+{
+    std::vector<int> keys = bench::random_ints(state.range());
+    for (auto _ : state)
+    {
+        state.pause_timing();
+        Set<int> set;
+        for (int key : keys) set.insert(key);
+        state.resume_timing();
+        for (int key : keys) set.erase(key);
+        bench::do_not_optimize(set.size());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Set_erase)->range(100, 10'000'000);
+
+static void BM_std_set_erase(bench::State& state)
+{
+    std::vector<int> keys = bench::random_ints(state.range());
+    for (auto _ : state)
+    {
+        state.pause_timing();
+        std::set<int> set(keys.begin(), keys.end());
+        state.resume_timing();
+        for (int key : keys) set.erase(key);
+        bench::do_not_optimize(set.size());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_set_erase)->range(100, 10'000'000);
+
+static void BM_Set_lower_bound(bench::State& state)
+{
+    std::vector<int> keys = bench::random_ints(state.range());
+    std::vector<int> queries = bench::random_ints(state.range(), 1 << 30, 7);
+    Set<int> set;
+    for (int key : keys) set.insert(key);
+    for (auto _ : state)
+    {
+        std::size_t hits = 0;
+        for (int query : queries) hits += set.lower_bound(query) != set.end();
+        bench::do_not_optimize(hits);
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Set_lower_bound)->range(100, 10'000'000);
+
+static void BM_std_set_lower_bound(bench::State& state)
+{
+    std::vector<int> keys = bench::random_ints(state.range());
+    std::vector<int> queries = bench::random_ints(state.range(), 1 << 30, 7);
+    std::set<int> set(keys.begin(), keys.end());
+    for (auto _ : state)
+    {
+        std::size_t hits = 0;
+        for (int query : queries) hits += set.lower_bound(query) != set.end();
+        bench::do_not_optimize(hits);
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_set_lower_bound)->range(100, 10'000'000);
+
+// string keys looked up through string_views into a larger buffer, as a parser would hold them
+static std::vector<std::string> string_keys(std::size_t count)
+{
+    std::vector<std::string> keys;
+    keys.reserve(count);
+    for (int key : bench::random_ints(count)) keys.push_back("session-identifier-" + std::to_string(key));
+    return keys;
+}
+
+template <typename StringSet, typename Probe>
+static void string_lookup(bench::State& state, Probe probe)
+{
+    std::vector<std::string> keys = string_keys(state.range());
+    StringSet set;
+    for (const std::string& key : keys) set.insert(key);
+    std::vector<std::string_view> views(keys.begin(), keys.end());
+    for (auto _ : state)
+    {
+        std::size_t found = 0;
+        for (std::string_view view : views) found += probe(set, view);
+        bench::do_not_optimize(found);
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+
+// std::less<>: the string_view is compared directly
+static void BM_Set_string_view_lookup_transparent(bench::State& state)
+{
+    string_lookup<Set<std::string, std::less<>>>(state, [](const auto& set, std::string_view view) { return set.contains(view); });
+}
+BENCHMARK(BM_Set_string_view_lookup_transparent)->range(100, 1'000'000);
+
+// std::less<std::string>: every lookup first copies the view into a std::string
+static void BM_Set_string_view_lookup_copy(bench::State& state)
+{
+    string_lookup<Set<std::string>>(state, [](const auto& set, std::string_view view) { return set.contains(std::string(view)); });
+}
+BENCHMARK(BM_Set_string_view_lookup_copy)->range(100, 1'000'000);
+
+// two sets of state.range() random keys each, overlapping in about half their keys
+template <typename Body>
+static void set_algebra(bench::State& state, Body body)
+{
+    std::vector<int> left = bench::random_ints(state.range(), static_cast<int>(state.range()) * 2, 1);
+    std::vector<int> right = bench::random_ints(state.range(), static_cast<int>(state.range()) * 2, 2);
+    body(state, left, right);
+    state.set_items_processed(state.iterations() * state.range() * 2);
+}
+
+static void BM_Set_union(bench::State& state)
+{
+    set_algebra(state,
+                [](bench::State& state, const std::vector<int>& left, const std::vector<int>& right)
+                {
+                    Set<int> a(left.begin(), left.end());
+                    Set<int> b(right.begin(), right.end());
+                    for (auto _ : state) bench::do_not_optimize(a.set_union(b).size());
+                });
+}
+BENCHMARK(BM_Set_union)->range(1000, 10'000'000);
+
+static void BM_Set_union_par(bench::State& state)
+{
+    set_algebra(state,
+                [](bench::State& state, const std::vector<int>& left, const std::vector<int>& right)
+                {
+                    Set<int> a(left.begin(), left.end());
+                    Set<int> b(right.begin(), right.end());
+                    for (auto _ : state) bench::do_not_optimize(a.set_union(exec::par, b).size());
+                });
+}
+BENCHMARK(BM_Set_union_par)->range(1000, 10'000'000);
+
+static void BM_Set_intersect(bench::State& state)
+{
+    set_algebra(state,
+                [](bench::State& state, const std::vector<int>& left, const std::vector<int>& right)
+                {
+                    Set<int> a(left.begin(), left.end());
+                    Set<int> b(right.begin(), right.end());
+                    for (auto _ : state) bench::do_not_optimize(a.intersect(b).size());
+                });
+}
+BENCHMARK(BM_Set_intersect)->range(1000, 10'000'000);
+
+// the usual std:: route: std::set_union into a std::set through a hinted inserter
+static void BM_std_set_union(bench::State& state)
+{
+    set_algebra(state,
+                [](bench::State& state, const std::vector<int>& left, const std::vector<int>& right)
+                {
+                    std::set<int> a(left.begin(), left.end());
+                    std::set<int> b(right.begin(), right.end());
+                    for (auto _ : state)
+                    {
+                        std::set<int> result;
+                        std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::inserter(result, result.end()));
+                        bench::do_not_optimize(result.size());
+                    }
+                });
+}
+BENCHMARK(BM_std_set_union)->range(1000, 10'000'000);
+
+static void BM_Set_equal(bench::State& state)
+{
+    set_algebra(state,
+                [](bench::State& state, const std::vector<int>& left, const std::vector<int>&)
+                {
+                    Set<int> a(left.begin(), left.end());
+                    Set<int> b;
+                    for (auto it = left.rbegin(); it != left.rend(); ++it) b.insert(*it);
+                    for (auto _ : state) bench::do_not_optimize(a == b);
+                });
+}
+BENCHMARK(BM_Set_equal)->range(1000, 10'000'000);
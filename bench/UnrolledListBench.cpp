@@ -0,0 +1,101 @@
+#include <iterator>
+#include <list>
+#include <vector>
+
+#include "../include/List.h"
+#include "../include/UnrolledList.h"
+#include "Benchmark.h"
+
+template <typename Sequence>
+static void push_back_ints(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        Sequence list;
+        for (std::size_t i = 0; i < state.range(); ++i) list.push_back(static_cast<int>(i));
+        bench::do_not_optimize(list.back());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+
+static void BM_UnrolledList_push_back(bench::State& state) { push_back_ints<UnrolledList<int>>(state); }
+BENCHMARK(BM_UnrolledList_push_back)->range(100, 10'000'000);
+
+template <typename Sequence>
+static void iterate_ints(bench::State& state)
+{
+    Sequence list;
+    for (std::size_t i = 0; i < state.range(); ++i) list.push_back(static_cast<int>(i));
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        for (int value : list) sum += value;
+        bench::do_not_optimize(sum);
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+
+static void BM_UnrolledList_iterate(bench::State& state) { iterate_ints<UnrolledList<int>>(state); }
+BENCHMARK(BM_UnrolledList_iterate)->range(100, 1'000'000);
+
+// the same traversal after the nodes have been scattered by random-position inserts
+template <typename Sequence>
+static void iterate_scattered(bench::State& state)
+{
+    std::vector<int> positions = bench::random_ints(state.range(), 1 << 30, 3);
+    Sequence list;
+    for (std::size_t i = 0; i < state.range(); ++i)
+    {
+        auto it = list.begin();
+        if (i > 0) std::advance(it, positions[i] % (i / 64 + 1));
+        list.insert(it, static_cast<int>(i));
+    }
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        for (int value : list) sum += value;
+        bench::do_not_optimize(sum);
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+
+static void BM_UnrolledList_iterate_scattered(bench::State& state) { iterate_scattered<UnrolledList<int>>(state); }
+BENCHMARK(BM_UnrolledList_iterate_scattered)->range(100, 100'000);
+
+static void BM_List_iterate_scattered(bench::State& state) { iterate_scattered<List<int>>(state); }
+BENCHMARK(BM_List_iterate_scattered)->range(100, 100'000);
+
+static void BM_std_list_iterate_scattered(bench::State& state) { iterate_scattered<std::list<int>>(state); }
+BENCHMARK(BM_std_list_iterate_scattered)->range(100, 100'000);
+
+// 100 inserts per iteration, each at a random position that has to be walked to first
+template <typename Sequence>
+static void insert_middle(bench::State& state)
+{
+    constexpr std::size_t inserts = 100;
+    std::vector<int> positions = bench::random_ints(inserts, 1 << 30, 7);
+    for (auto _ : state)
+    {
+        state.pause_timing();
+        Sequence list;
+        for (std::size_t i = 0; i < state.range(); ++i) list.push_back(static_cast<int>(i));
+        state.resume_timing();
+        for (std::size_t i = 0; i < inserts; ++i)
+        {
+            auto it = list.begin();
+            std::advance(it, positions[i] % state.range());
+            list.insert(it, static_cast<int>(i));
+        }
+        bench::do_not_optimize(list.front());
+    }
+    state.set_items_processed(state.iterations() * inserts);
+}
+
+static void BM_UnrolledList_insert_middle(bench::State& state) { insert_middle<UnrolledList<int>>(state); }
+BENCHMARK(BM_UnrolledList_insert_middle)->range(100, 100'000);
+
+static void BM_List_insert_middle(bench::State& state) { insert_middle<List<int>>(state); }
+BENCHMARK(BM_List_insert_middle)->range(100, 100'000);
+
+static void BM_std_list_insert_middle(bench::State& state) { insert_middle<std::list<int>>(state); }
+BENCHMARK(BM_std_list_insert_middle)->range(100, 100'000);
@@ -0,0 +1,397 @@
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../include/MallocAllocator.h"
+#include "../include/MonotonicArena.h"
+#include "../include/SmallVector.h"
+#include "../include/ThreadPool.h"
+#include "../include/Vector.h"
+#include "Benchmark.h"
+
+static void BM_Vector_push_back(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        Vector<int> vector;
+        for (std::size_t i = 0; i < state.range(); ++i) vector.push_back(static_cast<int>(i));
+        bench::do_not_optimize(vector.data());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Vector_push_back)->range(100, 10'000'000);
+
+static void BM_std_vector_push_back(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        std::vector<int> vector;
+        for (std::size_t i = 0; i < state.range(); ++i) vector.push_back(static_cast<int>(i));
+        bench::do_not_optimize(vector.data());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_vector_push_back)->range(100, 10'000'000);
+
+template <typename Growth>
+static void BM_Vector_push_back_growth(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        Vector<int, std::allocator<int>, Growth> vector;
+        for (std::size_t i = 0; i < state.range(); ++i) vector.push_back(static_cast<int>(i));
+        bench::do_not_optimize(vector.data());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Vector_push_back_growth<OneAndHalfGrowth>)->range(100, 10'000'000);
+BENCHMARK(BM_Vector_push_back_growth<FixedChunkGrowth<4096>>)->range(100, 1'000'000);
+BENCHMARK(BM_Vector_push_back_growth<HugePageGrowth<>>)->range(100, 10'000'000);
+
+// growth through realloc, which can remap large buffers instead of copying them
+static void BM_Vector_push_back_realloc(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        Vector<int, MallocAllocator<int>> vector;
+        for (std::size_t i = 0; i < state.range(); ++i) vector.push_back(static_cast<int>(i));
+        bench::do_not_optimize(vector.data());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Vector_push_back_realloc)->range(100, 10'000'000);
+
+// per-request scratch vector: every growth is carved from the arena, teardown is a single release()
+static void BM_Vector_push_back_arena(bench::State& state)
+{
+    MonotonicArena arena(1 << 20);
+    for (auto _ : state)
+    {
+        {
+            Vector<int, ArenaAllocator<int>> vector(arena);
+            for (std::size_t i = 0; i < state.range(); ++i) vector.push_back(static_cast<int>(i));
+            bench::do_not_optimize(vector.data());
+        }
+        arena.release();
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Vector_push_back_arena)->range(100, 10'000'000);
+
+// loading a batch: one capacity computation and one memcpy instead of n push_backs
+static void BM_Vector_append(bench::State& state)
+{
+    std::vector<int> batch = bench::random_ints(state.range());
+    for (auto _ : state)
+    {
+        Vector<int> vector;
+        vector.append(batch);
+        bench::do_not_optimize(vector.data());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Vector_append)->range(100, 10'000'000);
+
+static void BM_std_vector_insert_range(bench::State& state)
+{
+    std::vector<int> batch = bench::random_ints(state.range());
+    for (auto _ : state)
+    {
+        std::vector<int> vector;
+        vector.insert(vector.end(), batch.begin(), batch.end());
+        bench::do_not_optimize(vector.data());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_vector_insert_range)->range(100, 10'000'000);
+
+static void BM_Vector_emplace_back_string(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        Vector<std::string> vector;
+        for (std::size_t i = 0; i < state.range(); ++i) vector.emplace_back(24, 'x');
+        bench::do_not_optimize(vector.data());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Vector_emplace_back_string)->range(100, 10'000'000);
+
+static void BM_std_vector_emplace_back_string(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        std::vector<std::string> vector;
+        for (std::size_t i = 0; i < state.range(); ++i) vector.emplace_back(24, 'x');
+        bench::do_not_optimize(vector.data());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_vector_emplace_back_string)->range(100, 10'000'000);
+
+// many short-lived vectors of a few elements: the common case SmallVector is built for
+static void BM_Vector_small(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < state.range(); ++i)
+        {
+            Vector<int> vector;
+            for (int j = 0; j < 8; ++j) vector.push_back(j);
+            bench::do_not_optimize(vector.data());
+        }
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Vector_small)->range(100, 1'000'000);
+
+static void BM_SmallVector_small(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < state.range(); ++i)
+        {
+            SmallVector<int, 16> vector;
+            for (int j = 0; j < 8; ++j) vector.push_back(j);
+            bench::do_not_optimize(vector.data());
+        }
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_SmallVector_small)->range(100, 1'000'000);
+
+static void BM_std_vector_small(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < state.range(); ++i)
+        {
+            std::vector<int> vector;
+            for (int j = 0; j < 8; ++j) vector.push_back(j);
+            bench::do_not_optimize(vector.data());
+        }
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_vector_small)->range(100, 1'000'000);
+
+static void BM_Vector_equal(bench::State& state)
+{
+    Vector<int> left(state.range(), 7);
+    Vector<int> right(state.range(), 7);
+    for (auto _ : state)
+    {
+        bench::do_not_optimize(left == right);
+        bench::clobber_memory();
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Vector_equal)->range(100, 10'000'000);
+
+static void BM_std_vector_equal(bench::State& state)
+{
+    std::vector<int> left(state.range(), 7);
+    std::vector<int> right(state.range(), 7);
+    for (auto _ : state)
+    {
+        bench::do_not_optimize(left == right);
+        bench::clobber_memory();
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_vector_equal)->range(100, 10'000'000);
+
+// the needle sits in the last slot, so both versions scan everything
+static void BM_Vector_find(bench::State& state)
+{
+    Vector<int> vector(state.range(), 7);
+    vector.back() = 8;
+    for (auto _ : state)
+    {
+        bench::do_not_optimize(vector.find(8));
+        bench::clobber_memory();
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Vector_find)->range(100, 10'000'000);
+
+static void BM_std_find(bench::State& state)
+{
+    std::vector<int> vector(state.range(), 7);
+    vector.back() = 8;
+    for (auto _ : state)
+    {
+        bench::do_not_optimize(std::find(vector.begin(), vector.end(), 8));
+        bench::clobber_memory();
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_find)->range(100, 10'000'000);
+
+static void BM_Vector_count(bench::State& state)
+{
+    std::vector<int> values = bench::random_ints(state.range(), 16);
+    Vector<int> vector;
+    vector.append(values);
+    for (auto _ : state)
+    {
+        bench::do_not_optimize(vector.count(3));
+        bench::clobber_memory();
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Vector_count)->range(100, 10'000'000);
+
+static void BM_std_count(bench::State& state)
+{
+    std::vector<int> vector = bench::random_ints(state.range(), 16);
+    for (auto _ : state)
+    {
+        bench::do_not_optimize(std::count(vector.begin(), vector.end(), 3));
+        bench::clobber_memory();
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_count)->range(100, 10'000'000);
+
+static void BM_Vector_min(bench::State& state)
+{
+    std::vector<int> values = bench::random_ints(state.range());
+    Vector<int> vector;
+    vector.append(values);
+    for (auto _ : state)
+    {
+        bench::do_not_optimize(vector.min());
+        bench::clobber_memory();
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Vector_min)->range(100, 10'000'000);
+
+static void BM_std_min_element(bench::State& state)
+{
+    std::vector<int> vector = bench::random_ints(state.range());
+    for (auto _ : state)
+    {
+        bench::do_not_optimize(*std::min_element(vector.begin(), vector.end()));
+        bench::clobber_memory();
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_min_element)->range(100, 10'000'000);
+
+static void BM_Vector_fill(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        Vector<int> vector(state.range(), 7);
+        bench::do_not_optimize(vector.data());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Vector_fill)->range(100, 10'000'000);
+
+static void BM_std_vector_fill(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        std::vector<int> vector(state.range(), 7);
+        bench::do_not_optimize(vector.data());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_vector_fill)->range(100, 10'000'000);
+
+// a buffer sized and then overwritten in full, as when reading a file into it
+static void BM_Vector_resize_then_fill(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        Vector<char> buffer;
+        buffer.resize(state.range());
+        std::memset(buffer.data(), 'x', state.range());
+        bench::do_not_optimize(buffer.data());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Vector_resize_then_fill)->range(1'000, 100'000'000);
+
+static void BM_Vector_resize_uninitialized_then_fill(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        Vector<char> buffer;
+        buffer.resize_uninitialized(state.range());
+        std::memset(buffer.data(), 'x', state.range());
+        bench::do_not_optimize(buffer.data());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Vector_resize_uninitialized_then_fill)->range(1'000, 100'000'000);
+
+static void BM_std_vector_resize_then_fill(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        std::vector<char> buffer;
+        buffer.resize(state.range());
+        std::memset(buffer.data(), 'x', state.range());
+        bench::do_not_optimize(buffer.data());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_std_vector_resize_then_fill)->range(1'000, 100'000'000);
+
+// copying a large vector: exec::seq is the single-threaded baseline for exec::par
+static void BM_Vector_copy_from_seq(bench::State& state)
+{
+    std::vector<int> source = bench::random_ints(state.range());
+    for (auto _ : state)
+    {
+        Vector<int> vector;
+        vector.copy_from(exec::seq, source.begin(), source.end());
+        bench::do_not_optimize(vector.data());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Vector_copy_from_seq)->range(1'000, 100'000'000);
+
+static void BM_Vector_copy_from_par(bench::State& state)
+{
+    std::vector<int> source = bench::random_ints(state.range());
+    for (auto _ : state)
+    {
+        Vector<int> vector;
+        vector.copy_from(exec::par, source.begin(), source.end());
+        bench::do_not_optimize(vector.data());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Vector_copy_from_par)->range(1'000, 100'000'000);
+
+static void BM_Vector_fill_par(bench::State& state)
+{
+    Vector<int> vector;
+    vector.resize_uninitialized(state.range());
+    for (auto _ : state)
+    {
+        vector.fill(exec::par, 7);
+        bench::clobber_memory();
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Vector_fill_par)->range(1'000, 100'000'000);
+
+static void BM_Vector_transform_par(bench::State& state)
+{
+    std::vector<int> source = bench::random_ints(state.range());
+    for (auto _ : state)
+    {
+        Vector<double> vector;
+        vector.transform(exec::par, source.begin(), source.end(), [](int value) { return value * 0.5; });
+        bench::do_not_optimize(vector.data());
+    }
+    state.set_items_processed(state.iterations() * state.range());
+}
+BENCHMARK(BM_Vector_transform_par)->range(1'000, 100'000'000);
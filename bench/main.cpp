@@ -0,0 +1,3 @@
+#include "Benchmark.h"
+
+int main(int argc, char** argv) { return bench::run_benchmarks(argc, argv); }
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "ForwardList.h"
+
+// Multi-producer handoff of ForwardList nodes between threads. push_front is lock-free: it
+// links a node in with one compare-and-swap on the head. A consumer detaches everything
+// pushed so far with take_all(), a single atomic exchange, and gets it back as an ordinary
+// ForwardList, newest element first; reverse() it for arrival order. Nodes only ever leave
+// all at once, so none is freed while a producer may still read it, which rules out ABA and
+// makes a reclamation scheme unnecessary. take_all() may also be called from several threads.
+//
+// Producers allocate through the list's allocator and the consumer's batch frees through a
+// copy of it, so the allocator must be thread-safe: std::allocator or a default-constructed
+// PoolAllocator.
+template <typename T, typename Alloc = std::allocator<T>>
+class ConcurrentForwardList
+{
+   public:
+    using list_type = ForwardList<T, Alloc>;
+    using allocator_type = Alloc;
+
+   private:
+    using Node = typename list_type::Node;
+    using node_allocator = typename list_type::node_allocator;
+    using node_traits = typename list_type::node_traits;
+
+    // the only contended word; a cache line of its own keeps producers from falsely sharing
+    // it with whatever is allocated next to the list
+    alignas(64) std::atomic<Node*> head_;
+    [[no_unique_address]] node_allocator alloc_;
+
+    // publish the chain first..last, already linked together, in front of the current head
+    void link(Node* first, Node* last) noexcept;
+
+   public:
+    ConcurrentForwardList();
+    explicit ConcurrentForwardList(const Alloc& alloc);
+    ConcurrentForwardList(const ConcurrentForwardList&) = delete;
+    ConcurrentForwardList& operator=(const ConcurrentForwardList&) = delete;
+    // frees what was never taken; no other thread may still be using the list
+    ~ConcurrentForwardList();
+
+    allocator_type get_allocator() const;
+
+    // lock-free; any number of threads may push at once
+    void push_front(const T& value);
+    // publish every node of batch with a single compare-and-swap, keeping batch's order in
+    // front of the current elements; batch must have an equal allocator and is left empty
+    void push_front(list_type&& batch);
+    // detach every element pushed so far, newest first
+    list_type take_all() noexcept;
+    // a snapshot: other threads may push or take at any moment
+    bool empty() const noexcept;
+};
+
+template <typename T, typename Alloc>
+ConcurrentForwardList<T, Alloc>::ConcurrentForwardList() : ConcurrentForwardList(Alloc())
+{
+}
+
+template <typename T, typename Alloc>
+ConcurrentForwardList<T, Alloc>::ConcurrentForwardList(const Alloc& alloc) : head_(nullptr), alloc_(alloc)
+{
+}
+
+template <typename T, typename Alloc>
+ConcurrentForwardList<T, Alloc>::~ConcurrentForwardList()
+{
+    take_all().clear();
+}
+
+template <typename T, typename Alloc>
+typename ConcurrentForwardList<T, Alloc>::allocator_type ConcurrentForwardList<T, Alloc>::get_allocator() const
+{
+    return allocator_type(alloc_);
+}
+
+template <typename T, typename Alloc>
+void ConcurrentForwardList<T, Alloc>::link(Node* first, Node* last) noexcept
+{
+    Node* expected = head_.load(std::memory_order_relaxed);
+    do
+    {
+        last->next = expected;
+    } while (!head_.compare_exchange_weak(expected, first, std::memory_order_release, std::memory_order_relaxed));
+}
+
+template <typename T, typename Alloc>
+void ConcurrentForwardList<T, Alloc>::push_front(const T& value)
+{
+    Node* node = node_traits::allocate(alloc_, 1);
+    try
+    {
+        node_traits::construct(alloc_, node, value);
+    }
+    catch (...)
+    {
+        node_traits::deallocate(alloc_, node, 1);
+        throw;
+    }
+    link(node, node);
+}
+
+template <typename T, typename Alloc>
+void ConcurrentForwardList<T, Alloc>::push_front(list_type&& batch)
+{
+    if (!batch.head) return;
+
+    Node* last = batch.lastNode();
+    link(std::exchange(batch.head, nullptr), last);
+}
+
+template <typename T, typename Alloc>
+typename ConcurrentForwardList<T, Alloc>::list_type ConcurrentForwardList<T, Alloc>::take_all() noexcept
+{
+    // acquire pairs with the release in link(), making the pushed elements visible
+    return list_type(head_.exchange(nullptr, std::memory_order_acquire), allocator_type(alloc_));
+}
+
+template <typename T, typename Alloc>
+bool ConcurrentForwardList<T, Alloc>::empty() const noexcept
+{
+    return head_.load(std::memory_order_relaxed) == nullptr;
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "HazardPointer.h"
+
+// Lock-free LIFO stack (Treiber's): push and pop each link or unlink the top node with one
+// compare-and-swap, so any number of threads may use it at once, e.g. as a shared free list.
+// A popping thread protects the top node with a hazard pointer before reading its successor,
+// and popped nodes are retired to the stack's HazardDomain rather than freed; a node is
+// therefore never reused while another thread may still compare against its address (ABA),
+// and never freed while another thread reads it.
+//
+// Nodes are allocated and freed from different threads, so the allocator must be
+// thread-safe: std::allocator or a default-constructed PoolAllocator.
+template <typename T, typename Alloc = std::allocator<T>>
+class ConcurrentStack
+{
+   public:
+    using allocator_type = Alloc;
+
+   private:
+    struct Node : HazardDomain::Retired
+    {
+        T data;
+        Node* next = nullptr;
+
+        template <typename... Args>
+        explicit Node(Args&&... args) : data(std::forward<Args>(args)...)
+        {
+        }
+    };
+    using node_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using node_traits = std::allocator_traits<node_allocator>;
+
+    // the contended word on a cache line of its own
+    alignas(64) std::atomic<Node*> head_;
+    [[no_unique_address]] node_allocator alloc_;
+    // declared last so that its destructor, which frees the retired nodes, runs while alloc_ lives
+    HazardDomain domain_;
+
+    void destroyNode(Node* node) noexcept;
+    static void reclaimNode(HazardDomain::Retired* object, void* context) noexcept;
+
+   public:
+    ConcurrentStack();
+    explicit ConcurrentStack(const Alloc& alloc);
+    ConcurrentStack(const ConcurrentStack&) = delete;
+    ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+    // no other thread may still be using the stack
+    ~ConcurrentStack();
+
+    allocator_type get_allocator() const;
+
+    // lock-free
+    void push(const T& value);
+    void push(T&& value);
+    template <typename... Args>
+    void emplace(Args&&... args);
+    // lock-free; empty if the stack was empty when looked at
+    std::optional<T> pop();
+    // a snapshot: other threads may push or pop at any moment
+    bool empty() const noexcept;
+};
+
+template <typename T, typename Alloc>
+ConcurrentStack<T, Alloc>::ConcurrentStack() : ConcurrentStack(Alloc())
+{
+}
+
+template <typename T, typename Alloc>
+ConcurrentStack<T, Alloc>::ConcurrentStack(const Alloc& alloc) : head_(nullptr), alloc_(alloc), domain_(&reclaimNode, this)
+{
+}
+
+template <typename T, typename Alloc>
+ConcurrentStack<T, Alloc>::~ConcurrentStack()
+{
+    Node* node = head_.load(std::memory_order_acquire);
+    while (node)
+    {
+        Node* next = node->next;
+        destroyNode(node);
+        node = next;
+    }
+}
+
+template <typename T, typename Alloc>
+typename ConcurrentStack<T, Alloc>::allocator_type ConcurrentStack<T, Alloc>::get_allocator() const
+{
+    return allocator_type(alloc_);
+}
+
+template <typename T, typename Alloc>
+void ConcurrentStack<T, Alloc>::destroyNode(Node* node) noexcept
+{
+    node_traits::destroy(alloc_, node);
+    node_traits::deallocate(alloc_, node, 1);
+}
+
+template <typename T, typename Alloc>
+void ConcurrentStack<T, Alloc>::reclaimNode(HazardDomain::Retired* object, void* context) noexcept
+{
+    static_cast<ConcurrentStack*>(context)->destroyNode(static_cast<Node*>(object));
+}
+
+template <typename T, typename Alloc>
+void ConcurrentStack<T, Alloc>::push(const T& value)
+{
+    emplace(value);
+}
+
+template <typename T, typename Alloc>
+void ConcurrentStack<T, Alloc>::push(T&& value)
+{
+    emplace(std::move(value));
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+void ConcurrentStack<T, Alloc>::emplace(Args&&... args)
+{
+    Node* node = node_traits::allocate(alloc_, 1);
+    try
+    {
+        node_traits::construct(alloc_, node, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        node_traits::deallocate(alloc_, node, 1);
+        throw;
+    }
+
+    Node* top = head_.load(std::memory_order_relaxed);
+    do
+    {
+        node->next = top;
+    } while (!head_.compare_exchange_weak(top, node, std::memory_order_release, std::memory_order_relaxed));
+}
+
+template <typename T, typename Alloc>
+std::optional<T> ConcurrentStack<T, Alloc>::pop()
+{
+    HazardPointer hazard(domain_);
+    Node* node;
+    for (;;)
+    {
+        node = hazard.protect(head_);
+        if (!node) return std::nullopt;
+        // node cannot be freed while protected, so reading its successor is safe even if
+        // another thread pops it first; the CAS then fails and we retry
+        if (head_.compare_exchange_weak(node, node->next, std::memory_order_acquire, std::memory_order_relaxed))
+            break;
+    }
+    hazard.reset();
+
+    // node is ours now; other threads may still read node->next, but never data
+    std::optional<T> value;
+    try
+    {
+        value.emplace(std::move(node->data));
+    }
+    catch (...)
+    {
+        domain_.retire(node);
+        throw;
+    }
+    domain_.retire(node);
+    return value;
+}
+
+template <typename T, typename Alloc>
+bool ConcurrentStack<T, Alloc>::empty() const noexcept
+{
+    return head_.load(std::memory_order_relaxed) == nullptr;
+}
@@ -1,12 +1,19 @@
 #pragma once
 
+#include <functional>
 #include <iterator>
 #include <initializer_list>
+#include <memory>
 #include <stdexcept>
 #include <utility>
 #include <type_traits>
 
-template <typename T>
+#include "detail/ListSort.h"
+
+template <typename T, typename Alloc>
+class ConcurrentForwardList;
+
+template <typename T, typename Alloc = std::allocator<T>, bool TrackTail = false>
 class ForwardList
 {
 private:
@@ -15,7 +22,38 @@ private:
 		Node* next;
 		Node(const T& value) : data(value), next(nullptr) {}
 	};
+	using node_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+	using node_traits = std::allocator_traits<node_allocator>;
+
+	struct NoTail {};
+
+	[[no_unique_address]] node_allocator alloc_;
 	Node* head;
+	// the last node, kept only with TrackTail
+	[[no_unique_address]] std::conditional_t<TrackTail, Node*, NoTail> tail_{};
+
+	Node* createNode(const T& value);
+	void destroyNode(Node* node) noexcept;
+	// with TrackTail, record node as the last one; a no-op otherwise
+	void setTail(Node* node) noexcept;
+	// with TrackTail, find the last node again after the links were rebuilt
+	void recomputeTail() noexcept;
+	// the last node (nullptr if empty): tail_ with TrackTail, otherwise found by walking
+	Node* lastNode() const noexcept;
+	// copy [begin, end) in order after the last node
+	template <typename InputIt>
+	void appendRange(InputIt begin, InputIt end);
+	// take every node of other, which must use an equal allocator; this list must be empty
+	void stealNodes(ForwardList<T, Alloc, TrackTail>& other) noexcept;
+	// the link that points at the node after position: head for before_begin()
+	Node*& linkAfter(Node* position) noexcept;
+	static T& valueOf(Node* node) noexcept;
+
+	// adopt a null-terminated chain of nodes allocated with an equal allocator
+	ForwardList(Node* chain, const Alloc& alloc) noexcept;
+
+	template <typename, typename>
+	friend class ConcurrentForwardList;
 public:
 	class iterator {
 	private:
@@ -62,28 +100,68 @@ public:
 		const T* operator->() const;
 	};
 
+	using allocator_type = Alloc;
+
 	//constructors
 	ForwardList();
-	ForwardList(size_t size);
-	ForwardList(size_t size, const T& value);
-	ForwardList(const ForwardList<T>& other);
-	ForwardList(std::initializer_list<T> init);
+	explicit ForwardList(const Alloc& alloc);
+	ForwardList(size_t size, const Alloc& alloc = Alloc());
+	ForwardList(size_t size, const T& value, const Alloc& alloc = Alloc());
+	ForwardList(const ForwardList<T, Alloc, TrackTail>& other);
+	// constant time: takes other's nodes and allocator, leaving other empty
+	ForwardList(ForwardList<T, Alloc, TrackTail>&& other) noexcept;
+	ForwardList(std::initializer_list<T> init, const Alloc& alloc = Alloc());
 	template <typename InputIt>
-	ForwardList(InputIt begin, InputIt end);
+	ForwardList(InputIt begin, InputIt end, const Alloc& alloc = Alloc());
 	~ForwardList();
 
+	allocator_type get_allocator() const;
+
 	//
 	void push_front(const T& value);
 	void pop_front();
+	// constant-time FIFO operations, only when the list tracks its tail
+	void push_back(const T& value) requires TrackTail;
+	T& back() requires TrackTail;
+	const T& back() const requires TrackTail;
+	// move all of other's nodes to the end; constant time with TrackTail, otherwise it walks this list
+	void append(ForwardList<T, Alloc, TrackTail>&& other);
 	template <typename... Args>
 	void emplace_front(Args&&... args);
 	void insert_after(const iterator& it, const T& value);
-	void erase_after(const ForwardList<T>::iterator& it);
+	void erase_after(const ForwardList<T, Alloc, TrackTail>::iterator& it);
+
+	//relinking: no allocations or element copies; other lists must have an equal allocator
+	// move all of other's nodes after pos; linear in other's length (to find its last node)
+	void splice_after(const iterator& pos, ForwardList<T, Alloc, TrackTail>& other);
+	void splice_after(const iterator& pos, ForwardList<T, Alloc, TrackTail>&& other);
+	// move the node after it
+	void splice_after(const iterator& pos, ForwardList<T, Alloc, TrackTail>& other, const iterator& it);
+	void splice_after(const iterator& pos, ForwardList<T, Alloc, TrackTail>&& other, const iterator& it);
+	// move the nodes strictly between first and last
+	void splice_after(const iterator& pos, ForwardList<T, Alloc, TrackTail>& other, const iterator& first, const iterator& last);
+	void splice_after(const iterator& pos, ForwardList<T, Alloc, TrackTail>&& other, const iterator& first, const iterator& last);
+	// merge a sorted list into this sorted one; stable, and other is left empty
+	void merge(ForwardList<T, Alloc, TrackTail>& other);
+	template <typename Compare>
+	void merge(ForwardList<T, Alloc, TrackTail>& other, Compare comp);
+	// stable bottom-up merge sort: O(n log n) comparisons, no allocations
+	void sort();
+	template <typename Compare>
+	void sort(Compare comp);
+	void reverse() noexcept;
+	// erase each element equal to the one before it; returns the number erased
+	std::size_t unique();
+	template <typename BinaryPredicate>
+	std::size_t unique(BinaryPredicate equal);
 
 	//operators
-	bool operator==(const ForwardList<T>& other) const;
-	bool operator!=(const ForwardList<T>& other) const;
-	ForwardList<T>& operator=(const ForwardList<T>& other);
+	bool operator==(const ForwardList<T, Alloc, TrackTail>& other) const;
+	bool operator!=(const ForwardList<T, Alloc, TrackTail>& other) const;
+	ForwardList<T, Alloc, TrackTail>& operator=(const ForwardList<T, Alloc, TrackTail>& other);
+	// constant time unless the allocators differ and do not propagate; then the elements are copied
+	ForwardList<T, Alloc, TrackTail>& operator=(ForwardList<T, Alloc, TrackTail>&& other) noexcept(
+		node_traits::propagate_on_container_move_assignment::value || node_traits::is_always_equal::value);
 
 	//funcs
 	bool empty() const;
@@ -101,37 +179,37 @@ public:
 	iterator before_begin();
 };
 
-template <typename T>
-ForwardList<T>::iterator::iterator(Node* node) : current(node)
+template <typename T, typename Alloc, bool TrackTail>
+ForwardList<T, Alloc, TrackTail>::iterator::iterator(Node* node) : current(node)
 {
 }
 
-template <typename T>
-ForwardList<T>::iterator::iterator(Node* node, Node* head_) : current(node), head(head_)
+template <typename T, typename Alloc, bool TrackTail>
+ForwardList<T, Alloc, TrackTail>::iterator::iterator(Node* node, Node* head_) : current(node), head(head_)
 {
 }
 
-template <typename T>
-T& ForwardList<T>::iterator::operator*()
+template <typename T, typename Alloc, bool TrackTail>
+T& ForwardList<T, Alloc, TrackTail>::iterator::operator*()
 {
     if (!current) throw std::out_of_range("Dereferencing end iterator");
     return current->data;
 }
 
-template <typename T>
-bool ForwardList<T>::iterator::operator!=(const iterator& other) const
+template <typename T, typename Alloc, bool TrackTail>
+bool ForwardList<T, Alloc, TrackTail>::iterator::operator!=(const iterator& other) const
 {
     return current != other.current;
 }
 
-template <typename T>
-bool ForwardList<T>::iterator::operator==(const iterator& other) const
+template <typename T, typename Alloc, bool TrackTail>
+bool ForwardList<T, Alloc, TrackTail>::iterator::operator==(const iterator& other) const
 {
     return current == other.current;
 }
 
-template <typename T>
-typename ForwardList<T>::iterator& ForwardList<T>::iterator::operator++()
+template <typename T, typename Alloc, bool TrackTail>
+typename ForwardList<T, Alloc, TrackTail>::iterator& ForwardList<T, Alloc, TrackTail>::iterator::operator++()
 {
     if (current == nullptr)
         current = head;
@@ -140,8 +218,8 @@ typename ForwardList<T>::iterator& ForwardList<T>::iterator::operator++()
     return *this;
 }
 
-template <typename T>
-typename ForwardList<T>::iterator ForwardList<T>::iterator::operator++(int)
+template <typename T, typename Alloc, bool TrackTail>
+typename ForwardList<T, Alloc, TrackTail>::iterator ForwardList<T, Alloc, TrackTail>::iterator::operator++(int)
 {
     iterator tmp = *this;
     if (current == nullptr)
@@ -151,69 +229,103 @@ typename ForwardList<T>::iterator ForwardList<T>::iterator::operator++(int)
     return tmp;
 }
 
-template <typename T>
-T* ForwardList<T>::iterator::operator->()
+template <typename T, typename Alloc, bool TrackTail>
+T* ForwardList<T, Alloc, TrackTail>::iterator::operator->()
 {
     return &(current->data);
 }
 
-template <typename T>
-ForwardList<T>::const_iterator::const_iterator(const Node* node) : current(node)
+template <typename T, typename Alloc, bool TrackTail>
+ForwardList<T, Alloc, TrackTail>::const_iterator::const_iterator(const Node* node) : current(node)
 {
 }
 
-template <typename T>
-ForwardList<T>::const_iterator::const_iterator(const iterator& it) : current(it.current)
+template <typename T, typename Alloc, bool TrackTail>
+ForwardList<T, Alloc, TrackTail>::const_iterator::const_iterator(const iterator& it) : current(it.current)
 {
 }
 
-template <typename T>
-const T& ForwardList<T>::const_iterator::operator*() const
+template <typename T, typename Alloc, bool TrackTail>
+const T& ForwardList<T, Alloc, TrackTail>::const_iterator::operator*() const
 {
     if (!current) throw std::out_of_range("Dereferencing end iterator");
     return current->data;
 }
 
-template <typename T>
-const T* ForwardList<T>::const_iterator::operator->() const
+template <typename T, typename Alloc, bool TrackTail>
+const T* ForwardList<T, Alloc, TrackTail>::const_iterator::operator->() const
 {
     return &(current->data);
 }
 
-template <typename T>
-bool ForwardList<T>::const_iterator::operator!=(const const_iterator& other) const
+template <typename T, typename Alloc, bool TrackTail>
+bool ForwardList<T, Alloc, TrackTail>::const_iterator::operator!=(const const_iterator& other) const
 {
     return current != other.current;
 }
 
-template <typename T>
-bool ForwardList<T>::const_iterator::operator==(const const_iterator& other) const
+template <typename T, typename Alloc, bool TrackTail>
+bool ForwardList<T, Alloc, TrackTail>::const_iterator::operator==(const const_iterator& other) const
 {
     return current == other.current;
 }
 
-template <typename T>
-typename ForwardList<T>::const_iterator& ForwardList<T>::const_iterator::operator++()
+template <typename T, typename Alloc, bool TrackTail>
+typename ForwardList<T, Alloc, TrackTail>::const_iterator& ForwardList<T, Alloc, TrackTail>::const_iterator::operator++()
 {
     if (current) current = current->next;
     return *this;
 }
 
-template <typename T>
-typename ForwardList<T>::const_iterator ForwardList<T>::const_iterator::operator++(int)
+template <typename T, typename Alloc, bool TrackTail>
+typename ForwardList<T, Alloc, TrackTail>::const_iterator ForwardList<T, Alloc, TrackTail>::const_iterator::operator++(int)
 {
     const_iterator tmp = *this;
     if (current) current = current->next;
     return tmp;
 }
 
-template <typename T>
-ForwardList<T>::ForwardList() : head(nullptr)
+template <typename T, typename Alloc, bool TrackTail>
+typename ForwardList<T, Alloc, TrackTail>::Node* ForwardList<T, Alloc, TrackTail>::createNode(const T& value)
+{
+    Node* node = node_traits::allocate(alloc_, 1);
+    try
+    {
+        node_traits::construct(alloc_, node, value);
+    }
+    catch (...)
+    {
+        node_traits::deallocate(alloc_, node, 1);
+        throw;
+    }
+    return node;
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+void ForwardList<T, Alloc, TrackTail>::destroyNode(Node* node) noexcept
+{
+    node_traits::destroy(alloc_, node);
+    node_traits::deallocate(alloc_, node, 1);
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+ForwardList<T, Alloc, TrackTail>::ForwardList() : ForwardList(Alloc())
+{
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+ForwardList<T, Alloc, TrackTail>::ForwardList(const Alloc& alloc) : alloc_(alloc), head(nullptr)
+{
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+ForwardList<T, Alloc, TrackTail>::ForwardList(Node* chain, const Alloc& alloc) noexcept : alloc_(alloc), head(chain)
 {
+    recomputeTail();
 }
 
-template <typename T>
-ForwardList<T>::ForwardList(size_t size) : head(nullptr)
+template <typename T, typename Alloc, bool TrackTail>
+ForwardList<T, Alloc, TrackTail>::ForwardList(size_t size, const Alloc& alloc) : alloc_(alloc), head(nullptr)
 {
     for (size_t i = 0; i < size; ++i)
     {
@@ -221,8 +333,8 @@ ForwardList<T>::ForwardList(size_t size) : head(nullptr)
     }
 }
 
-template <typename T>
-ForwardList<T>::ForwardList(size_t size, const T& value) : head(nullptr)
+template <typename T, typename Alloc, bool TrackTail>
+ForwardList<T, Alloc, TrackTail>::ForwardList(size_t size, const T& value, const Alloc& alloc) : alloc_(alloc), head(nullptr)
 {
     for (size_t i = 0; i < size; ++i)
     {
@@ -230,60 +342,71 @@ ForwardList<T>::ForwardList(size_t size, const T& value) : head(nullptr)
     }
 }
 
-template <typename T>
-ForwardList<T>::ForwardList(const ForwardList<T>& other) : head(nullptr)
+template <typename T, typename Alloc, bool TrackTail>
+ForwardList<T, Alloc, TrackTail>::ForwardList(const ForwardList<T, Alloc, TrackTail>& other)
+    : alloc_(node_traits::select_on_container_copy_construction(other.alloc_)), head(nullptr)
 {
-    Node* tmp = other.head;
-    Node* prev = nullptr;
-    while (tmp)
+    try
     {
-        Node* newNode = new Node(tmp->data);
-        if (prev)
-            prev->next = newNode;
-        else
-            head = newNode;
-        prev = newNode;
-        tmp = tmp->next;
+        appendRange(other.begin(), other.end());
+    }
+    catch (...)
+    {
+        clear();
+        throw;
     }
 }
 
-template <typename T>
-ForwardList<T>::ForwardList(std::initializer_list<T> init) : head(nullptr)
+template <typename T, typename Alloc, bool TrackTail>
+ForwardList<T, Alloc, TrackTail>::ForwardList(ForwardList<T, Alloc, TrackTail>&& other) noexcept
+    : alloc_(std::move(other.alloc_)), head(nullptr)
 {
-    for (auto it = init.end(); it != init.begin();)
+    stealNodes(other);
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+ForwardList<T, Alloc, TrackTail>::ForwardList(std::initializer_list<T> init, const Alloc& alloc) : alloc_(alloc), head(nullptr)
+{
+    try
     {
-        --it;
-        emplace_front(*it);
+        appendRange(init.begin(), init.end());
+    }
+    catch (...)
+    {
+        clear();
+        throw;
     }
 }
 
-template <typename T>
+template <typename T, typename Alloc, bool TrackTail>
 template <typename InputIt>
-ForwardList<T>::ForwardList(InputIt begin, InputIt end) : head(nullptr)
+ForwardList<T, Alloc, TrackTail>::ForwardList(InputIt begin, InputIt end, const Alloc& alloc) : alloc_(alloc), head(nullptr)
 {
-    ForwardList<T> temp;
-    while (begin != end)
+    try
     {
-        temp.push_front(*begin);
-        ++begin;
+        appendRange(begin, end);
     }
-
-    Node* tmp = temp.head;
-    while (tmp)
+    catch (...)
     {
-        push_front(tmp->data);
-        tmp = tmp->next;
+        clear();
+        throw;
     }
 }
 
-template <typename T>
-ForwardList<T>::~ForwardList()
+template <typename T, typename Alloc, bool TrackTail>
+typename ForwardList<T, Alloc, TrackTail>::allocator_type ForwardList<T, Alloc, TrackTail>::get_allocator() const
+{
+    return Alloc(alloc_);
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+ForwardList<T, Alloc, TrackTail>::~ForwardList()
 {
     clear();
 }
 
-template <typename T>
-bool ForwardList<T>::operator==(const ForwardList<T>& other) const
+template <typename T, typename Alloc, bool TrackTail>
+bool ForwardList<T, Alloc, TrackTail>::operator==(const ForwardList<T, Alloc, TrackTail>& other) const
 {
     Node* tmp1 = head;
     Node* tmp2 = other.head;
@@ -296,58 +419,116 @@ bool ForwardList<T>::operator==(const ForwardList<T>& other) const
     return tmp1 == nullptr && tmp2 == nullptr;
 }
 
-template <typename T>
-bool ForwardList<T>::operator!=(const ForwardList<T>& other) const
+template <typename T, typename Alloc, bool TrackTail>
+bool ForwardList<T, Alloc, TrackTail>::operator!=(const ForwardList<T, Alloc, TrackTail>& other) const
 {
     return !(*this == other);
 }
 
-template <typename T>
-ForwardList<T>& ForwardList<T>::operator=(const ForwardList<T>& other)
+template <typename T, typename Alloc, bool TrackTail>
+ForwardList<T, Alloc, TrackTail>& ForwardList<T, Alloc, TrackTail>::operator=(const ForwardList<T, Alloc, TrackTail>& other)
 {
     if (this == &other) return *this;
 
     clear();
+    if constexpr (node_traits::propagate_on_container_copy_assignment::value) alloc_ = other.alloc_;
 
-    Node* tmp = other.head;
-    Node* prev = nullptr;
-    while (tmp)
+    appendRange(other.begin(), other.end());
+    return *this;
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+ForwardList<T, Alloc, TrackTail>& ForwardList<T, Alloc, TrackTail>::operator=(ForwardList<T, Alloc, TrackTail>&& other) noexcept(
+    node_traits::propagate_on_container_move_assignment::value || node_traits::is_always_equal::value)
+{
+    if (this == &other) return *this;
+
+    clear();
+    if constexpr (node_traits::propagate_on_container_move_assignment::value)
     {
-        Node* newNode = new Node(tmp->data);
-        if (prev)
-            prev->next = newNode;
-        else
-            head = newNode;
-        prev = newNode;
-        tmp = tmp->next;
+        alloc_ = std::move(other.alloc_);
     }
-
+    else if (alloc_ != other.alloc_)
+    {
+        // our allocator cannot free other's nodes: copy the elements into nodes of our own
+        appendRange(other.begin(), other.end());
+        other.clear();
+        return *this;
+    }
+    stealNodes(other);
     return *this;
 }
 
-template <typename T>
-void ForwardList<T>::push_front(const T& value)
+template <typename T, typename Alloc, bool TrackTail>
+void ForwardList<T, Alloc, TrackTail>::stealNodes(ForwardList<T, Alloc, TrackTail>& other) noexcept
 {
-    Node* tmp = new Node(value);
+    head = std::exchange(other.head, nullptr);
+    tail_ = other.tail_;
+    other.setTail(nullptr);
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+void ForwardList<T, Alloc, TrackTail>::push_front(const T& value)
+{
+    Node* tmp = createNode(value);
     tmp->next = head;
     head = tmp;
+    if (!tmp->next) setTail(tmp);
 }
 
-template <typename T>
-void ForwardList<T>::pop_front()
+template <typename T, typename Alloc, bool TrackTail>
+void ForwardList<T, Alloc, TrackTail>::pop_front()
 {
     if (head)
     {
         Node* tmp = head;
         head = head->next;
-        delete tmp;
+        destroyNode(tmp);
+        if (!head) setTail(nullptr);
     }
 }
 
-template <typename T>
-void ForwardList<T>::insert_after(const ForwardList<T>::iterator& it, const T& value)
+template <typename T, typename Alloc, bool TrackTail>
+void ForwardList<T, Alloc, TrackTail>::push_back(const T& value) requires TrackTail
 {
-    Node* tmp = new Node(value);
+    Node* tmp = createNode(value);
+    linkAfter(tail_) = tmp;
+    tail_ = tmp;
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+T& ForwardList<T, Alloc, TrackTail>::back() requires TrackTail
+{
+    if (tail_)
+    {
+        return tail_->data;
+    }
+    throw std::out_of_range("List is empty");
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+const T& ForwardList<T, Alloc, TrackTail>::back() const requires TrackTail
+{
+    if (tail_)
+    {
+        return tail_->data;
+    }
+    throw std::out_of_range("List is empty");
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+void ForwardList<T, Alloc, TrackTail>::append(ForwardList<T, Alloc, TrackTail>&& other)
+{
+    if (&other == this || !other.head) return;
+
+    linkAfter(lastNode()) = std::exchange(other.head, nullptr);
+    if constexpr (TrackTail) tail_ = std::exchange(other.tail_, nullptr);
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+void ForwardList<T, Alloc, TrackTail>::insert_after(const ForwardList<T, Alloc, TrackTail>::iterator& it, const T& value)
+{
+    Node* tmp = createNode(value);
     if (it.get_current() == nullptr)
     {
         tmp->next = head;
@@ -358,10 +539,11 @@ void ForwardList<T>::insert_after(const ForwardList<T>::iterator& it, const T& v
         tmp->next = it.get_current()->next;
         it.get_current()->next = tmp;
     }
+    if (!tmp->next) setTail(tmp);
 }
 
-template <typename T>
-void ForwardList<T>::erase_after(const ForwardList<T>::iterator& it)
+template <typename T, typename Alloc, bool TrackTail>
+void ForwardList<T, Alloc, TrackTail>::erase_after(const ForwardList<T, Alloc, TrackTail>::iterator& it)
 {
     if (it.get_current() == nullptr)
     {
@@ -369,7 +551,8 @@ void ForwardList<T>::erase_after(const ForwardList<T>::iterator& it)
         {
             Node* tmp = head;
             head = head->next;
-            delete tmp;
+            destroyNode(tmp);
+            if (!head) setTail(nullptr);
         }
         return;
     }
@@ -379,27 +562,29 @@ void ForwardList<T>::erase_after(const ForwardList<T>::iterator& it)
     if (tmp != nullptr)
     {
         it.get_current()->next = tmp->next;
-        delete tmp;
+        if (!tmp->next) setTail(it.get_current());
+        destroyNode(tmp);
     }
 }
 
-template <typename T>
+template <typename T, typename Alloc, bool TrackTail>
 template <typename... Args>
-void ForwardList<T>::emplace_front(Args&&... args)
+void ForwardList<T, Alloc, TrackTail>::emplace_front(Args&&... args)
 {
-    Node* tmp = new Node(T(std::forward<Args>(args)...));
+    Node* tmp = createNode(T(std::forward<Args>(args)...));
     tmp->next = head;
     head = tmp;
+    if (!tmp->next) setTail(tmp);
 }
 
-template <typename T>
-bool ForwardList<T>::empty() const
+template <typename T, typename Alloc, bool TrackTail>
+bool ForwardList<T, Alloc, TrackTail>::empty() const
 {
     return head == nullptr;
 }
 
-template <typename T>
-T& ForwardList<T>::front()
+template <typename T, typename Alloc, bool TrackTail>
+T& ForwardList<T, Alloc, TrackTail>::front()
 {
     if (head)
     {
@@ -408,8 +593,8 @@ T& ForwardList<T>::front()
     throw std::out_of_range("List is empty");
 }
 
-template <typename T>
-const T& ForwardList<T>::front() const
+template <typename T, typename Alloc, bool TrackTail>
+const T& ForwardList<T, Alloc, TrackTail>::front() const
 {
     if (head)
     {
@@ -418,8 +603,8 @@ const T& ForwardList<T>::front() const
     throw std::out_of_range("List is empty");
 }
 
-template <typename T>
-void ForwardList<T>::clear()
+template <typename T, typename Alloc, bool TrackTail>
+void ForwardList<T, Alloc, TrackTail>::clear()
 {
     while (head)
     {
@@ -427,44 +612,270 @@ void ForwardList<T>::clear()
     }
 }
 
-template <typename T>
-typename ForwardList<T>::iterator ForwardList<T>::before_begin()
+template <typename T, typename Alloc, bool TrackTail>
+typename ForwardList<T, Alloc, TrackTail>::iterator ForwardList<T, Alloc, TrackTail>::before_begin()
 {
     return iterator(nullptr, head);
 }
 
-template <typename T>
-typename ForwardList<T>::iterator ForwardList<T>::begin()
+template <typename T, typename Alloc, bool TrackTail>
+typename ForwardList<T, Alloc, TrackTail>::iterator ForwardList<T, Alloc, TrackTail>::begin()
 {
     return iterator(head);
 }
 
-template <typename T>
-typename ForwardList<T>::iterator ForwardList<T>::end()
+template <typename T, typename Alloc, bool TrackTail>
+typename ForwardList<T, Alloc, TrackTail>::iterator ForwardList<T, Alloc, TrackTail>::end()
 {
     return iterator(nullptr);
 }
 
-template <typename T>
-typename ForwardList<T>::const_iterator ForwardList<T>::begin() const
+template <typename T, typename Alloc, bool TrackTail>
+typename ForwardList<T, Alloc, TrackTail>::const_iterator ForwardList<T, Alloc, TrackTail>::begin() const
 {
     return const_iterator(head);
 }
 
-template <typename T>
-typename ForwardList<T>::const_iterator ForwardList<T>::end() const
+template <typename T, typename Alloc, bool TrackTail>
+typename ForwardList<T, Alloc, TrackTail>::const_iterator ForwardList<T, Alloc, TrackTail>::end() const
 {
     return const_iterator(nullptr);
 }
 
-template <typename T>
-typename ForwardList<T>::const_iterator ForwardList<T>::cbegin() const
+template <typename T, typename Alloc, bool TrackTail>
+typename ForwardList<T, Alloc, TrackTail>::const_iterator ForwardList<T, Alloc, TrackTail>::cbegin() const
 {
     return const_iterator(head);
 }
 
-template <typename T>
-typename ForwardList<T>::const_iterator ForwardList<T>::cend() const
+template <typename T, typename Alloc, bool TrackTail>
+typename ForwardList<T, Alloc, TrackTail>::const_iterator ForwardList<T, Alloc, TrackTail>::cend() const
 {
     return const_iterator(nullptr);
 }
+
+template <typename T, typename Alloc, bool TrackTail>
+typename ForwardList<T, Alloc, TrackTail>::Node*& ForwardList<T, Alloc, TrackTail>::linkAfter(Node* position) noexcept
+{
+    return position ? position->next : head;
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+void ForwardList<T, Alloc, TrackTail>::setTail([[maybe_unused]] Node* node) noexcept
+{
+    if constexpr (TrackTail) tail_ = node;
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+void ForwardList<T, Alloc, TrackTail>::recomputeTail() noexcept
+{
+    if constexpr (TrackTail)
+    {
+        Node* last = head;
+        while (last && last->next) last = last->next;
+        tail_ = last;
+    }
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+typename ForwardList<T, Alloc, TrackTail>::Node* ForwardList<T, Alloc, TrackTail>::lastNode() const noexcept
+{
+    if constexpr (TrackTail)
+    {
+        return tail_;
+    }
+    else
+    {
+        Node* last = head;
+        while (last && last->next) last = last->next;
+        return last;
+    }
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+template <typename InputIt>
+void ForwardList<T, Alloc, TrackTail>::appendRange(InputIt begin, InputIt end)
+{
+    Node** link = &linkAfter(lastNode());
+    while (begin != end)
+    {
+        Node* node = createNode(*begin);
+        *link = node;
+        link = &node->next;
+        setTail(node);
+        ++begin;
+    }
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+T& ForwardList<T, Alloc, TrackTail>::valueOf(Node* node) noexcept
+{
+    return node->data;
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+void ForwardList<T, Alloc, TrackTail>::splice_after(const iterator& pos, ForwardList<T, Alloc, TrackTail>& other)
+{
+    if (&other == this || !other.head) return;
+
+    Node* last = other.lastNode();
+    Node*& link = linkAfter(pos.get_current());
+    last->next = link;
+    link = other.head;
+    other.head = nullptr;
+    other.setTail(nullptr);
+    if (!last->next) setTail(last);
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+void ForwardList<T, Alloc, TrackTail>::splice_after(const iterator& pos, ForwardList<T, Alloc, TrackTail>&& other)
+{
+    splice_after(pos, other);
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+void ForwardList<T, Alloc, TrackTail>::splice_after(const iterator& pos, ForwardList<T, Alloc, TrackTail>& other, const iterator& it)
+{
+    Node*& source = other.linkAfter(it.get_current());
+    Node* node = source;
+    if (!node) return;
+    if (&other == this && (pos.get_current() == it.get_current() || pos.get_current() == node)) return;
+
+    source = node->next;
+    if (!source) other.setTail(it.get_current());
+    Node*& link = linkAfter(pos.get_current());
+    node->next = link;
+    link = node;
+    if (!node->next) setTail(node);
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+void ForwardList<T, Alloc, TrackTail>::splice_after(const iterator& pos, ForwardList<T, Alloc, TrackTail>&& other, const iterator& it)
+{
+    splice_after(pos, other, it);
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+void ForwardList<T, Alloc, TrackTail>::splice_after(const iterator& pos, ForwardList<T, Alloc, TrackTail>& other, const iterator& first,
+                                         const iterator& last)
+{
+    Node*& source = other.linkAfter(first.get_current());
+    Node* from = source;
+    Node* end = last.get_current();
+    if (from == end) return;
+
+    Node* back = from;
+    while (back->next != end) back = back->next;
+
+    source = end;
+    if (!end) other.setTail(first.get_current());
+    Node*& link = linkAfter(pos.get_current());
+    back->next = link;
+    link = from;
+    if (!back->next) setTail(back);
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+void ForwardList<T, Alloc, TrackTail>::splice_after(const iterator& pos, ForwardList<T, Alloc, TrackTail>&& other, const iterator& first,
+                                         const iterator& last)
+{
+    splice_after(pos, other, first, last);
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+void ForwardList<T, Alloc, TrackTail>::merge(ForwardList<T, Alloc, TrackTail>& other)
+{
+    merge(other, std::less<>());
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+template <typename Compare>
+void ForwardList<T, Alloc, TrackTail>::merge(ForwardList<T, Alloc, TrackTail>& other, Compare comp)
+{
+    if (&other == this) return;
+
+    Node* otherLast = other.lastNode();
+    other.setTail(nullptr);
+    try
+    {
+        detail::merge_runs(head, std::exchange(other.head, nullptr), &valueOf, comp);
+    }
+    catch (...)
+    {
+        recomputeTail();
+        throw;
+    }
+    // whichever run ran out last supplied the final node
+    if constexpr (TrackTail)
+    {
+        if (!tail_ || tail_->next) tail_ = otherLast;
+    }
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+void ForwardList<T, Alloc, TrackTail>::sort()
+{
+    sort(std::less<>());
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+template <typename Compare>
+void ForwardList<T, Alloc, TrackTail>::sort(Compare comp)
+{
+    try
+    {
+        detail::sort_chain(head, &valueOf, comp);
+    }
+    catch (...)
+    {
+        recomputeTail();
+        throw;
+    }
+    recomputeTail();
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+void ForwardList<T, Alloc, TrackTail>::reverse() noexcept
+{
+    setTail(head);
+    Node* reversed = nullptr;
+    while (head)
+    {
+        Node* next = head->next;
+        head->next = reversed;
+        reversed = head;
+        head = next;
+    }
+    head = reversed;
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+std::size_t ForwardList<T, Alloc, TrackTail>::unique()
+{
+    return unique(std::equal_to<>());
+}
+
+template <typename T, typename Alloc, bool TrackTail>
+template <typename BinaryPredicate>
+std::size_t ForwardList<T, Alloc, TrackTail>::unique(BinaryPredicate equal)
+{
+    std::size_t erased = 0;
+    if (!head) return erased;
+
+    Node* kept = head;
+    while (Node* node = kept->next)
+    {
+        if (equal(kept->data, node->data))
+        {
+            kept->next = node->next;
+            destroyNode(node);
+            ++erased;
+        }
+        else
+        {
+            kept = node;
+        }
+    }
+    setTail(kept);
+    return erased;
+}
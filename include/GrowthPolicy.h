@@ -0,0 +1,71 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+// Growth policies decide the capacity a Vector reallocates to. Each one exposes
+//
+//     static size_t next_capacity(size_t current, size_t required, size_t element_size);
+//
+// returning a capacity >= required. current is 0 when sizing a new buffer.
+
+// capacity is always a power of two (the historical Vector behaviour)
+struct PowerOfTwoGrowth
+{
+    static std::size_t next_capacity(std::size_t, std::size_t required, std::size_t)
+    {
+        if (required > (std::numeric_limits<std::size_t>::max() >> 1) + 1) throw std::length_error("Vector too large");
+        return std::bit_ceil(required);
+    }
+};
+
+struct DoublingGrowth
+{
+    static std::size_t next_capacity(std::size_t current, std::size_t required, std::size_t)
+    {
+        return std::max(required, current > std::numeric_limits<std::size_t>::max() / 2 ? required : current * 2);
+    }
+};
+
+// wastes at most a third of the buffer and lets freed blocks be reused by later growth
+struct OneAndHalfGrowth
+{
+    static std::size_t next_capacity(std::size_t current, std::size_t required, std::size_t)
+    {
+        return std::max(required, current > std::numeric_limits<std::size_t>::max() / 3 * 2 ? required : current + current / 2);
+    }
+};
+
+// grows by a constant number of elements: linear total copying, but no slack beyond Chunk
+template <std::size_t Chunk>
+struct FixedChunkGrowth
+{
+    static_assert(Chunk > 0, "chunk must not be empty");
+
+    static std::size_t next_capacity(std::size_t, std::size_t required, std::size_t)
+    {
+        if (required > std::numeric_limits<std::size_t>::max() - (Chunk - 1)) return required;
+        return (required + Chunk - 1) / Chunk * Chunk;
+    }
+};
+
+// small buffers follow Base; once a buffer reaches PageSize bytes its size is rounded up to
+// whole pages so transparent huge pages can back it without a partially used trailing page
+template <typename Base = OneAndHalfGrowth, std::size_t PageSize = std::size_t(2) << 20>
+struct HugePageGrowth
+{
+    static_assert(std::has_single_bit(PageSize), "page size must be a power of two");
+
+    static std::size_t next_capacity(std::size_t current, std::size_t required, std::size_t element_size)
+    {
+        std::size_t capacity = Base::next_capacity(current, required, element_size);
+        if (capacity > std::numeric_limits<std::size_t>::max() / element_size - PageSize) return capacity;
+
+        std::size_t bytes = capacity * element_size;
+        if (bytes < PageSize) return capacity;
+        return ((bytes + PageSize - 1) & ~(PageSize - 1)) / element_size;
+    }
+};
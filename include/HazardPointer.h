@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Safe memory reclamation for lock-free structures (Michael's hazard pointers). Before a
+// thread dereferences a shared node it publishes the node's address in a hazard slot; a
+// thread that unlinks a node retires it to the domain instead of freeing it, and the domain
+// hands it to the reclaimer only once no slot holds its address. Because a protected node
+// cannot be freed, it cannot be reallocated either, which also rules out ABA on the pointers
+// compared by a CAS.
+//
+// Each lock-free structure owns a domain. Retired objects derive from HazardDomain::Retired,
+// whose link chains them while they wait; the domain's destructor reclaims whatever is left.
+class HazardDomain
+{
+   public:
+    struct Retired
+    {
+        Retired* next_retired = nullptr;
+    };
+
+    // frees an object once it is safe; context is the one given to the constructor
+    using Reclaimer = void (*)(Retired* object, void* context) noexcept;
+
+   private:
+    struct Slot
+    {
+        std::atomic<const void*> hazard{nullptr};
+        std::atomic<bool> active{true};
+        Slot* next = nullptr;
+    };
+
+    // slots are never freed before the domain, only released for reuse
+    std::atomic<Slot*> slots_;
+    std::atomic<std::size_t> slot_count_;
+    std::atomic<Retired*> retired_;
+    std::atomic<std::size_t> retired_count_;
+    Reclaimer reclaim_;
+    void* context_;
+
+    Slot* acquire_slot();
+    bool is_hazard(const void* object) const noexcept;
+    void push_retired(Retired* first, Retired* last) noexcept;
+
+    friend class HazardPointer;
+
+   public:
+    HazardDomain(Reclaimer reclaim, void* context) noexcept;
+    HazardDomain(const HazardDomain&) = delete;
+    HazardDomain& operator=(const HazardDomain&) = delete;
+    // reclaims every retired object; no thread may still use the domain
+    ~HazardDomain();
+
+    // object must already be unreachable for threads that have not protected it. Once the
+    // retired list outgrows twice the number of slots, the calling thread scans it.
+    void retire(Retired* object) noexcept;
+    // reclaim every retired object that no slot protects
+    void scan() noexcept;
+};
+
+// One hazard slot of a domain, held for the lifetime of the object. A slot protects one
+// pointer at a time; the destructor clears it and returns the slot to the domain.
+class HazardPointer
+{
+   private:
+    HazardDomain::Slot* slot_;
+
+   public:
+    explicit HazardPointer(HazardDomain& domain);
+    HazardPointer(const HazardPointer&) = delete;
+    HazardPointer& operator=(const HazardPointer&) = delete;
+    ~HazardPointer();
+
+    // load source and publish it, retrying until the published value is still current, so
+    // the result stays valid until the next protect() or reset()
+    template <typename T>
+    T* protect(const std::atomic<T*>& source) noexcept;
+    void reset() noexcept;
+};
+
+template <typename T>
+T* HazardPointer::protect(const std::atomic<T*>& source) noexcept
+{
+    T* pointer = source.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        // seq_cst orders the publication before the reload, and against the scan's reads
+        slot_->hazard.store(pointer, std::memory_order_seq_cst);
+        T* current = source.load(std::memory_order_seq_cst);
+        if (current == pointer) return pointer;
+        pointer = current;
+    }
+}
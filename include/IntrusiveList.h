@@ -0,0 +1,549 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include "ListDebug.h"
+
+// Links embedded in an object so that IntrusiveList can chain it without allocating. An
+// object joins as many lists as it has hooks. Copying an object does not copy its list
+// memberships: a copied or assigned hook keeps its own state. An object must be unlinked
+// before it is destroyed.
+class IntrusiveListHook
+{
+   private:
+    IntrusiveListHook* next = nullptr;
+    IntrusiveListHook* previous = nullptr;
+
+    template <typename T, IntrusiveListHook T::*Hook>
+    friend class IntrusiveList;
+
+   public:
+    IntrusiveListHook() noexcept = default;
+    IntrusiveListHook(const IntrusiveListHook&) noexcept {}
+    IntrusiveListHook& operator=(const IntrusiveListHook&) noexcept { return *this; }
+
+    bool is_linked() const noexcept { return next != nullptr; }
+};
+
+// A doubly-linked list of objects it does not own, linked through their Hook member:
+//
+//     struct Page { int id; IntrusiveListHook lru; IntrusiveListHook dirty; };
+//     IntrusiveList<Page, &Page::lru> lru;
+//     IntrusiveList<Page, &Page::dirty> dirty;
+//
+// Inserting and unlinking never allocate, and unlink(object) needs no search. Like List, the
+// list is circular through a sentinel hook, so its iterators are a single pointer. Unlinked
+// hooks are reset, and clear() and the destructor unlink every element without touching the
+// objects otherwise.
+template <typename T, IntrusiveListHook T::*Hook>
+class IntrusiveList
+{
+   private:
+    IntrusiveListHook sentinel_;
+    std::size_t size_ = 0;
+
+    static T* owner(IntrusiveListHook* hook) noexcept;
+    static const T* owner(const IntrusiveListHook* hook) noexcept;
+    static void linkBefore(IntrusiveListHook* position, IntrusiveListHook* hook) noexcept;
+    static void unlinkHook(IntrusiveListHook* hook) noexcept;
+    // point the first and last hooks back at sentinel_ after it was copied from another list
+    void adoptRing() noexcept;
+
+   public:
+    class iterator
+    {
+       private:
+        IntrusiveListHook* current;
+
+        friend class IntrusiveList;
+        friend class const_iterator;
+
+       public:
+        iterator() : current(nullptr) {}
+        explicit iterator(IntrusiveListHook* hook) : current(hook) {}
+
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator& operator++();
+        iterator operator++(int);
+        iterator& operator--();
+        iterator operator--(int);
+        bool operator==(const iterator& right) const;
+        bool operator!=(const iterator& right) const;
+        T& operator*() const;
+        T* operator->() const;
+    };
+
+    class const_iterator
+    {
+       private:
+        const IntrusiveListHook* current;
+
+       public:
+        const_iterator() : current(nullptr) {}
+        explicit const_iterator(const IntrusiveListHook* hook) : current(hook) {}
+        const_iterator(const iterator& other);
+
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = const T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator& operator++();
+        const_iterator operator++(int);
+        const_iterator& operator--();
+        const_iterator operator--(int);
+        bool operator==(const const_iterator& right) const;
+        bool operator!=(const const_iterator& right) const;
+        const T& operator*() const;
+        const T* operator->() const;
+    };
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    IntrusiveList() noexcept;
+    IntrusiveList(const IntrusiveList&) = delete;
+    IntrusiveList& operator=(const IntrusiveList&) = delete;
+    IntrusiveList(IntrusiveList&& other) noexcept;
+    IntrusiveList& operator=(IntrusiveList&& other) noexcept;
+    ~IntrusiveList();
+
+    const_reverse_iterator crbegin() const;
+    const_reverse_iterator crend() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    reverse_iterator rbegin();
+    reverse_iterator rend();
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    // the position of an object in this list, found from its hook in constant time
+    iterator iterator_to(T& value) noexcept;
+
+    bool empty() const noexcept;
+    std::size_t size() const noexcept;
+    const T& front() const;
+    T& front();
+    const T& back() const;
+    T& back();
+
+    // link value, which must not be in a list through Hook yet, in front of it
+    iterator insert(const iterator& it, T& value);
+    void push_back(T& value);
+    void push_front(T& value);
+    // unlink the element at it and return the position after it
+    iterator erase(const iterator& it);
+    // unlink value, which must be in this list, in constant time
+    void unlink(T& value);
+    void pop_front();
+    void pop_back();
+    void clear() noexcept;
+
+    // relink value, which must be in this list, at one end: the "touch" of an LRU queue
+    void move_to_front(T& value);
+    void move_to_back(T& value);
+
+    void swap(IntrusiveList& other) noexcept;
+};
+
+template <typename T, IntrusiveListHook T::*Hook>
+T* IntrusiveList<T, Hook>::owner(IntrusiveListHook* hook) noexcept
+{
+    // the hook's offset in T, measured on storage no object lives in; it folds to a constant
+    alignas(T) unsigned char storage[sizeof(T)];
+    std::ptrdiff_t offset = reinterpret_cast<unsigned char*>(&(reinterpret_cast<T*>(storage)->*Hook)) - storage;
+    return reinterpret_cast<T*>(reinterpret_cast<unsigned char*>(hook) - offset);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+const T* IntrusiveList<T, Hook>::owner(const IntrusiveListHook* hook) noexcept
+{
+    return owner(const_cast<IntrusiveListHook*>(hook));
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::linkBefore(IntrusiveListHook* position, IntrusiveListHook* hook) noexcept
+{
+    IntrusiveListHook* before = position->previous;
+    hook->previous = before;
+    hook->next = position;
+    before->next = hook;
+    position->previous = hook;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::unlinkHook(IntrusiveListHook* hook) noexcept
+{
+    hook->previous->next = hook->next;
+    hook->next->previous = hook->previous;
+    hook->next = hook->previous = nullptr;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::adoptRing() noexcept
+{
+    if (size_ == 0)
+    {
+        sentinel_.next = sentinel_.previous = &sentinel_;
+        return;
+    }
+    sentinel_.next->previous = &sentinel_;
+    sentinel_.previous->next = &sentinel_;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::iterator& IntrusiveList<T, Hook>::iterator::operator++()
+{
+    current = current->next;
+    return *this;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::iterator IntrusiveList<T, Hook>::iterator::operator++(int)
+{
+    iterator temp = *this;
+    ++(*this);
+    return temp;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::iterator& IntrusiveList<T, Hook>::iterator::operator--()
+{
+    current = current->previous;
+    return *this;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::iterator IntrusiveList<T, Hook>::iterator::operator--(int)
+{
+    iterator temp = *this;
+    --(*this);
+    return temp;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+bool IntrusiveList<T, Hook>::iterator::operator==(const iterator& right) const
+{
+    return current == right.current;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+bool IntrusiveList<T, Hook>::iterator::operator!=(const iterator& right) const
+{
+    return !(*this == right);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+T& IntrusiveList<T, Hook>::iterator::operator*() const
+{
+    return *owner(current);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+T* IntrusiveList<T, Hook>::iterator::operator->() const
+{
+    return owner(current);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+IntrusiveList<T, Hook>::const_iterator::const_iterator(const iterator& other) : current(other.current)
+{
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::const_iterator& IntrusiveList<T, Hook>::const_iterator::operator++()
+{
+    current = current->next;
+    return *this;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::const_iterator IntrusiveList<T, Hook>::const_iterator::operator++(int)
+{
+    const_iterator temp = *this;
+    ++(*this);
+    return temp;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::const_iterator& IntrusiveList<T, Hook>::const_iterator::operator--()
+{
+    current = current->previous;
+    return *this;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::const_iterator IntrusiveList<T, Hook>::const_iterator::operator--(int)
+{
+    const_iterator temp = *this;
+    --(*this);
+    return temp;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+bool IntrusiveList<T, Hook>::const_iterator::operator==(const const_iterator& right) const
+{
+    return current == right.current;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+bool IntrusiveList<T, Hook>::const_iterator::operator!=(const const_iterator& right) const
+{
+    return !(*this == right);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+const T& IntrusiveList<T, Hook>::const_iterator::operator*() const
+{
+    return *owner(current);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+const T* IntrusiveList<T, Hook>::const_iterator::operator->() const
+{
+    return owner(current);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+IntrusiveList<T, Hook>::IntrusiveList() noexcept
+{
+    sentinel_.next = sentinel_.previous = &sentinel_;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+IntrusiveList<T, Hook>::IntrusiveList(IntrusiveList&& other) noexcept : IntrusiveList()
+{
+    swap(other);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+IntrusiveList<T, Hook>& IntrusiveList<T, Hook>::operator=(IntrusiveList&& other) noexcept
+{
+    if (this == &other) return *this;
+    clear();
+    swap(other);
+    return *this;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+IntrusiveList<T, Hook>::~IntrusiveList()
+{
+    clear();
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::const_reverse_iterator IntrusiveList<T, Hook>::crbegin() const
+{
+    return const_reverse_iterator(cend());
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::const_reverse_iterator IntrusiveList<T, Hook>::crend() const
+{
+    return const_reverse_iterator(cbegin());
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::const_iterator IntrusiveList<T, Hook>::cbegin() const
+{
+    return const_iterator(sentinel_.next);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::const_iterator IntrusiveList<T, Hook>::cend() const
+{
+    return const_iterator(&sentinel_);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::reverse_iterator IntrusiveList<T, Hook>::rbegin()
+{
+    return reverse_iterator(end());
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::reverse_iterator IntrusiveList<T, Hook>::rend()
+{
+    return reverse_iterator(begin());
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::iterator IntrusiveList<T, Hook>::begin()
+{
+    return iterator(sentinel_.next);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::iterator IntrusiveList<T, Hook>::end()
+{
+    return iterator(&sentinel_);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::const_iterator IntrusiveList<T, Hook>::begin() const
+{
+    return cbegin();
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::const_iterator IntrusiveList<T, Hook>::end() const
+{
+    return cend();
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::iterator IntrusiveList<T, Hook>::iterator_to(T& value) noexcept
+{
+    return iterator(&(value.*Hook));
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+bool IntrusiveList<T, Hook>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+std::size_t IntrusiveList<T, Hook>::size() const noexcept
+{
+    return size_;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+const T& IntrusiveList<T, Hook>::front() const
+{
+    LIST_CHECK(size_ != 0, "List is empty");
+    return *owner(sentinel_.next);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+T& IntrusiveList<T, Hook>::front()
+{
+    LIST_CHECK(size_ != 0, "List is empty");
+    return *owner(sentinel_.next);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+const T& IntrusiveList<T, Hook>::back() const
+{
+    LIST_CHECK(size_ != 0, "List is empty");
+    return *owner(sentinel_.previous);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+T& IntrusiveList<T, Hook>::back()
+{
+    LIST_CHECK(size_ != 0, "List is empty");
+    return *owner(sentinel_.previous);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::iterator IntrusiveList<T, Hook>::insert(const iterator& it, T& value)
+{
+    IntrusiveListHook* hook = &(value.*Hook);
+    LIST_CHECK(!hook->is_linked(), "Element is already linked");
+    linkBefore(it.current, hook);
+    ++size_;
+    return iterator(hook);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::push_back(T& value)
+{
+    insert(end(), value);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::push_front(T& value)
+{
+    insert(begin(), value);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::iterator IntrusiveList<T, Hook>::erase(const iterator& it)
+{
+    IntrusiveListHook* hook = it.current;
+    if (hook == &sentinel_) return end();
+
+    IntrusiveListHook* next = hook->next;
+    unlinkHook(hook);
+    --size_;
+    return iterator(next);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::unlink(T& value)
+{
+    IntrusiveListHook* hook = &(value.*Hook);
+    LIST_CHECK(hook->is_linked(), "Element is not linked");
+    unlinkHook(hook);
+    --size_;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::pop_front()
+{
+    if (!size_) return;
+    erase(begin());
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::pop_back()
+{
+    if (!size_) return;
+    erase(iterator(sentinel_.previous));
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::clear() noexcept
+{
+    IntrusiveListHook* hook = sentinel_.next;
+    while (hook != &sentinel_)
+    {
+        IntrusiveListHook* next = hook->next;
+        hook->next = hook->previous = nullptr;
+        hook = next;
+    }
+    sentinel_.next = sentinel_.previous = &sentinel_;
+    size_ = 0;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::move_to_front(T& value)
+{
+    IntrusiveListHook* hook = &(value.*Hook);
+    LIST_CHECK(hook->is_linked(), "Element is not linked");
+    if (sentinel_.next == hook) return;
+    unlinkHook(hook);
+    linkBefore(sentinel_.next, hook);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::move_to_back(T& value)
+{
+    IntrusiveListHook* hook = &(value.*Hook);
+    LIST_CHECK(hook->is_linked(), "Element is not linked");
+    if (sentinel_.previous == hook) return;
+    unlinkHook(hook);
+    linkBefore(&sentinel_, hook);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::swap(IntrusiveList& other) noexcept
+{
+    if (this == &other) return;
+    std::swap(sentinel_.next, other.sentinel_.next);
+    std::swap(sentinel_.previous, other.sentinel_.previous);
+    std::swap(size_, other.size_);
+    adoptRing();
+    other.adoptRing();
+}
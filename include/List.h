@@ -1,35 +1,82 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
 #include <initializer_list>
 #include <iostream>
-#include <optional>
+#include <memory>
+#include <utility>
 
-template <typename T>
+#include "ListDebug.h"
+#include "detail/ListSort.h"
+
+// Without LIST_DEBUG (see ListDebug.h) an iterator is a single node pointer and traversal
+// has no branches besides the loop condition.
+template <typename T, typename Alloc = std::allocator<T>>
 class List
 {
    private:
-    struct Node
+    // the links shared by real nodes and the sentinel, which has no element
+    struct NodeBase
+    {
+        NodeBase* next;
+        NodeBase* previous;
+    };
+    struct Node : NodeBase
     {
         T data;
-        Node* next;
-        Node* previous;
-        Node(const T& value);
+        template <typename... Args>
+        explicit Node(Args&&... args);
     };
-    Node* head;
-    Node* tail;
-    std::size_t size_;
+    using node_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using node_traits = std::allocator_traits<node_allocator>;
+
+    [[no_unique_address]] node_allocator alloc_;
+    // the list is circular through sentinel_: sentinel_.next is the first node,
+    // sentinel_.previous the last, and an empty list points it at itself
+    NodeBase sentinel_{&sentinel_, &sentinel_};
+    std::size_t size_ = 0;
+
+    template <typename... Args>
+    Node* createNode(Args&&... args);
+    void destroyNode(Node* node) noexcept;
+    static T& valueOf(NodeBase* node) noexcept;
+    // point the first and last nodes back at sentinel_ after it was copied from another list
+    void adoptRing() noexcept;
+    // take every node of other, which must use an equal allocator; this list must be empty
+    void stealNodes(List<T, Alloc>& other) noexcept;
+
+    // detach every node as a null-terminated chain (nullptr if empty), leaving size_ alone
+    NodeBase* unchain() noexcept;
+    // make the null-terminated chain starting at first the whole list, fixing previous links
+    void relink(NodeBase* first) noexcept;
+    // detach the nodes first..last (inclusive) from their list without touching size_
+    static void unlinkRange(NodeBase* first, NodeBase* last) noexcept;
+    // link the detached nodes first..last in front of position
+    static void linkRange(NodeBase* position, NodeBase* first, NodeBase* last) noexcept;
 
    public:
     class iterator
     {
        private:
-        std::optional<Node*> current;
-        List<T>* list_;
+        NodeBase* current;
+#ifdef LIST_DEBUG
+        const List<T, Alloc>* list_;
+#endif
+
+        friend class List<T, Alloc>;
+        friend class const_iterator;
 
        public:
-        explicit iterator(List<T>* list, std::optional<Node*> node) : list_(list), current(node) {}
-        explicit iterator(const List<T>* list, std::optional<Node*> node) : list_(list), current(node) {}
+        iterator() : iterator(nullptr, nullptr) {}
+        explicit iterator(NodeBase* node, [[maybe_unused]] const List<T, Alloc>* list)
+            : current(node)
+#ifdef LIST_DEBUG
+              ,
+              list_(list)
+#endif
+        {
+        }
 
         using iterator_category = std::bidirectional_iterator_tag;
         using value_type = T;
@@ -41,24 +88,29 @@ class List
         iterator operator++(int);
         iterator& operator--();
         iterator operator--(int);
-        bool operator==(const iterator& right);
         bool operator==(const iterator& right) const;
-        bool operator!=(const iterator& right);
-        T& operator*();
-        T* operator->();
-        Node* get_current() const;
-        std::optional<Node*> cur() const;
-        List<T>* lis() const;
+        bool operator!=(const iterator& right) const;
+        T& operator*() const;
+        T* operator->() const;
     };
 
     class reverse_iterator
     {
        private:
-        std::optional<Node*> current;
-        List<T>* list_;
+        NodeBase* current;
+#ifdef LIST_DEBUG
+        const List<T, Alloc>* list_;
+#endif
 
        public:
-        explicit reverse_iterator(List<T>* list, std::optional<Node*> node) : list_(list), current(node) {}
+        explicit reverse_iterator(NodeBase* node, [[maybe_unused]] const List<T, Alloc>* list)
+            : current(node)
+#ifdef LIST_DEBUG
+              ,
+              list_(list)
+#endif
+        {
+        }
 
         using iterator_category = std::bidirectional_iterator_tag;
         using value_type = T;
@@ -70,19 +122,29 @@ class List
         reverse_iterator operator++(int);
         reverse_iterator& operator--();
         reverse_iterator operator--(int);
-        bool operator==(const reverse_iterator& right);
-        bool operator!=(const reverse_iterator& right);
-        T& operator*();
+        bool operator==(const reverse_iterator& right) const;
+        bool operator!=(const reverse_iterator& right) const;
+        T& operator*() const;
     };
 
     class const_iterator
     {
        private:
-        std::optional<Node*> current;
-        const List<T>* list_;
+        const NodeBase* current;
+#ifdef LIST_DEBUG
+        const List<T, Alloc>* list_;
+#endif
 
        public:
-        explicit const_iterator(const List<T>* list, std::optional<Node*> node) : list_(list), current(node) {}
+        const_iterator() : const_iterator(nullptr, nullptr) {}
+        explicit const_iterator(const NodeBase* node, [[maybe_unused]] const List<T, Alloc>* list)
+            : current(node)
+#ifdef LIST_DEBUG
+              ,
+              list_(list)
+#endif
+        {
+        }
         const_iterator(const iterator& other);
 
         using iterator_category = std::bidirectional_iterator_tag;
@@ -95,22 +157,31 @@ class List
         const_iterator operator++(int);
         const_iterator& operator--();
         const_iterator operator--(int);
-        bool operator==(const const_iterator& right);
-        bool operator==(const iterator& right);
-        bool operator!=(const const_iterator& right);
-        bool operator!=(const iterator& right);
-        const T& operator*();
-        const T* operator->();
+        bool operator==(const const_iterator& right) const;
+        bool operator==(const iterator& right) const;
+        bool operator!=(const const_iterator& right) const;
+        bool operator!=(const iterator& right) const;
+        const T& operator*() const;
+        const T* operator->() const;
     };
 
     class const_reverse_iterator
     {
        private:
-        std::optional<Node*> current;
-        const List<T>* list_;
+        const NodeBase* current;
+#ifdef LIST_DEBUG
+        const List<T, Alloc>* list_;
+#endif
 
        public:
-        explicit const_reverse_iterator(const List<T>* list, std::optional<Node*> node) : list_(list), current(node) {}
+        explicit const_reverse_iterator(const NodeBase* node, [[maybe_unused]] const List<T, Alloc>* list)
+            : current(node)
+#ifdef LIST_DEBUG
+              ,
+              list_(list)
+#endif
+        {
+        }
 
         using iterator_category = std::bidirectional_iterator_tag;
         using value_type = const T;
@@ -122,20 +193,29 @@ class List
         const_reverse_iterator operator++(int);
         const_reverse_iterator& operator--();
         const_reverse_iterator operator--(int);
-        bool operator==(const const_reverse_iterator& right);
-        bool operator!=(const const_reverse_iterator& right);
-        const T& operator*();
+        bool operator==(const const_reverse_iterator& right) const;
+        bool operator!=(const const_reverse_iterator& right) const;
+        const T& operator*() const;
     };
 
+    using allocator_type = Alloc;
+
     List();
-    List(std::size_t size);
-    List(int size, const T& value);
-    List(const List<T>& copy);
-    List(std::initializer_list<T> init);
+    explicit List(const Alloc& alloc);
+    List(std::size_t size, const Alloc& alloc = Alloc());
+    List(int size, const T& value, const Alloc& alloc = Alloc());
+    List(const List<T, Alloc>& copy);
+    // take over other's nodes in constant time; other is left empty
+    List(List<T, Alloc>&& other) noexcept;
+    // as above when alloc equals other's allocator, otherwise moves the elements one by one
+    List(List<T, Alloc>&& other, const Alloc& alloc);
+    List(std::initializer_list<T> init, const Alloc& alloc = Alloc());
     template <typename inputIt>
-    List(inputIt begin, inputIt end);
+    List(inputIt begin, inputIt end, const Alloc& alloc = Alloc());
     ~List();
 
+    allocator_type get_allocator() const noexcept;
+
     const_reverse_iterator crbegin() const;
     const_reverse_iterator crend() const;
     const_iterator cbegin() const;
@@ -145,7 +225,8 @@ class List
     iterator begin();
     iterator end();
     const_iterator begin() const;
-    iterator end() const;
+    const_iterator end() const;
+    // the sentinel, which is also end(): the list is circular, so ++before_begin() == begin()
     iterator before_begin();
 
     std::size_t getSize();
@@ -157,220 +238,298 @@ class List
     const T& back() const;
     T& back();
 
-    void insert(const iterator& it, const T& value);
+    iterator insert(const iterator& it, const T& value);
+    iterator insert(const iterator& it, T&& value);
+    // construct an element from args directly in a new node in front of it
+    template <typename... Args>
+    iterator emplace(const iterator& it, Args&&... args);
     void erase(const iterator& it);
-    void merge(List<T>& list);
+    // merge a sorted list into this sorted one by relinking its nodes; stable, this list's
+    // elements go first among equals, and list is left empty. Both lists must have equal
+    // allocators, as must the lists passed to splice
+    void merge(List<T, Alloc>& list);
+    template <typename Compare>
+    void merge(List<T, Alloc>& list, Compare comp);
+
+    // move nodes of other in front of pos without copying or allocating; constant time
+    // except for a range from another list, which is linear in its length (to update sizes)
+    void splice(const iterator& pos, List<T, Alloc>& other);
+    void splice(const iterator& pos, List<T, Alloc>&& other);
+    void splice(const iterator& pos, List<T, Alloc>& other, const iterator& it);
+    void splice(const iterator& pos, List<T, Alloc>&& other, const iterator& it);
+    void splice(const iterator& pos, List<T, Alloc>& other, const iterator& first, const iterator& last);
+    void splice(const iterator& pos, List<T, Alloc>&& other, const iterator& first, const iterator& last);
+    // stable bottom-up merge sort that relinks nodes: O(n log n), no allocations, no element copies
     void sort();
+    template <typename Compare>
+    void sort(Compare comp);
     void swap(T& left, T& right);
+    // exchange the contents of two lists in constant time
+    void swap(List<T, Alloc>& other) noexcept;
 
     void push_back(const T& value);
+    void push_back(T&& value);
     void push_front(const T& value);
+    void push_front(T&& value);
+    template <typename... Args>
+    T& emplace_back(Args&&... args);
+    template <typename... Args>
+    T& emplace_front(Args&&... args);
     void pop_front();
     void pop_back();
     void clear();
 
-    bool operator==(const List& right);
-    bool operator!=(const List& right);
+    bool operator==(const List& right) const;
+    bool operator!=(const List& right) const;
     List& operator=(const List& right);
+    List& operator=(List&& right) noexcept(node_traits::propagate_on_container_move_assignment::value ||
+                                           node_traits::is_always_equal::value);
 };
 
-template <typename T>
-List<T>::const_iterator::const_iterator(const iterator& other) : current(other.cur()), list_(const_cast<const List<T>*>(other.lis()))
+template <typename T, typename Alloc>
+List<T, Alloc>::const_iterator::const_iterator(const iterator& other) : current(other.current)
+#ifdef LIST_DEBUG
+                                                                      ,
+                                                                      list_(other.list_)
+#endif
 {
 }
 
-template <typename T>
-std::size_t List<T>::getSize()
+template <typename T, typename Alloc>
+std::size_t List<T, Alloc>::getSize()
 {
     return size_;
 }
 
-template <typename T>
-void List<T>::swap(T& left, T& right)
+template <typename T, typename Alloc>
+void List<T, Alloc>::swap(T& left, T& right)
 {
     T temp = left;
     left = right;
     right = temp;
 }
 
-template <typename T>
-void List<T>::sort()
+template <typename T, typename Alloc>
+T& List<T, Alloc>::valueOf(NodeBase* node) noexcept
+{
+    return static_cast<Node*>(node)->data;
+}
+
+template <typename T, typename Alloc>
+typename List<T, Alloc>::NodeBase* List<T, Alloc>::unchain() noexcept
+{
+    if (sentinel_.next == &sentinel_) return nullptr;
+    NodeBase* first = sentinel_.next;
+    sentinel_.previous->next = nullptr;
+    sentinel_.next = sentinel_.previous = &sentinel_;
+    return first;
+}
+
+template <typename T, typename Alloc>
+void List<T, Alloc>::relink(NodeBase* first) noexcept
 {
-    auto it = begin();
-    auto jt = it;
-    while (it != end())
+    NodeBase* previous = &sentinel_;
+    for (NodeBase* node = first; node; node = node->next)
     {
-        it++;
-        jt = it;
-        it--;
-        while (jt != end())
-        {
-            if (*it > *jt)
-            {
-                swap(*it, *jt);
-            }
-            jt++;
-        }
-        it++;
+        previous->next = node;
+        node->previous = previous;
+        previous = node;
     }
+    previous->next = &sentinel_;
+    sentinel_.previous = previous;
 }
 
-template <typename T>
-void List<T>::merge(List<T>& list)
+template <typename T, typename Alloc>
+void List<T, Alloc>::sort()
 {
-    auto it1 = begin();
-    auto it2 = list.begin();
+    sort(std::less<>());
+}
 
-    List<T> newList;
+template <typename T, typename Alloc>
+template <typename Compare>
+void List<T, Alloc>::sort(Compare comp)
+{
+    if (size_ < 2) return;
 
-    while (it1 != end() && it2 != list.end())
+    NodeBase* chain = unchain();
+    try
     {
-        if (*it2 < *it1)
-        {
-            newList.push_back(*it2);
-            ++it2;
-        }
-        else
-        {
-            newList.push_back(*it1);
-            ++it1;
-        }
+        detail::sort_chain(chain, &valueOf, comp);
     }
-
-    while (it2 != list.end())
+    catch (...)
     {
-        newList.push_back(*it2);
-        ++it2;
+        relink(chain);
+        throw;
     }
-    while (it1 != end())
+    relink(chain);
+}
+
+template <typename T, typename Alloc>
+void List<T, Alloc>::merge(List<T, Alloc>& list)
+{
+    merge(list, std::less<>());
+}
+
+template <typename T, typename Alloc>
+template <typename Compare>
+void List<T, Alloc>::merge(List<T, Alloc>& list, Compare comp)
+{
+    if (&list == this || list.empty()) return;
+
+    NodeBase* merged = unchain();
+    NodeBase* other = list.unchain();
+    size_ += list.size_;
+    list.size_ = 0;
+    try
     {
-        newList.push_back(*it1);
-        ++it1;
+        detail::merge_runs(merged, other, &valueOf, comp);
     }
-
-    clear();
-    for (auto& value : newList)
+    catch (...)
     {
-        push_back(value);
+        relink(merged);
+        throw;
     }
-
-    list.clear();
+    relink(merged);
 }
 
-template <typename T>
-typename List<T>::Node* List<T>::iterator::get_current() const
+template <typename T, typename Alloc>
+void List<T, Alloc>::unlinkRange(NodeBase* first, NodeBase* last) noexcept
 {
-    return current.value_or(nullptr);
+    first->previous->next = last->next;
+    last->next->previous = first->previous;
 }
 
-template <typename T>
-std::optional<typename List<T>::Node*> List<T>::iterator::cur() const
+template <typename T, typename Alloc>
+void List<T, Alloc>::linkRange(NodeBase* position, NodeBase* first, NodeBase* last) noexcept
 {
-    return current;
+    NodeBase* before = position->previous;
+    first->previous = before;
+    last->next = position;
+    before->next = first;
+    position->previous = last;
 }
 
-template <typename T>
-List<T>* List<T>::iterator::lis() const
+template <typename T, typename Alloc>
+void List<T, Alloc>::splice(const iterator& pos, List<T, Alloc>& other)
 {
-    return list_;
+    LIST_CHECK(pos.list_ == this, "Iterator does not belong to this list");
+    if (&other == this || other.empty()) return;
+
+    NodeBase* first = other.sentinel_.next;
+    NodeBase* last = other.sentinel_.previous;
+    unlinkRange(first, last);
+    linkRange(pos.current, first, last);
+    size_ += other.size_;
+    other.size_ = 0;
 }
 
-template <typename T>
-T* List<T>::iterator::operator->()
+template <typename T, typename Alloc>
+void List<T, Alloc>::splice(const iterator& pos, List<T, Alloc>&& other)
 {
-    if (!current.has_value() || !current.value())
-    {
-        throw std::runtime_error("Dereferencing invalid iterator");
-    }
-    return &(current.value()->data);
+    splice(pos, other);
 }
 
-template <typename T>
-const T* List<T>::const_iterator::operator->()
+template <typename T, typename Alloc>
+void List<T, Alloc>::splice(const iterator& pos, List<T, Alloc>& other, const iterator& it)
 {
-    if (!current.has_value() || !current.value())
-    {
-        throw std::runtime_error("Dereferencing invalid iterator");
-    }
-    return &(current.value()->data);
+    LIST_CHECK(pos.list_ == this && it.list_ == &other, "Iterator does not belong to this list");
+    NodeBase* node = it.current;
+    NodeBase* position = pos.current;
+    if (node == &other.sentinel_) return;
+    if (&other == this && (node == position || node->next == position)) return;
+
+    unlinkRange(node, node);
+    --other.size_;
+    linkRange(position, node, node);
+    ++size_;
 }
 
-template <typename T>
-void List<T>::insert(const List<T>::iterator& it, const T& value)
+template <typename T, typename Alloc>
+void List<T, Alloc>::splice(const iterator& pos, List<T, Alloc>&& other, const iterator& it)
 {
-    if (it == end())
-    {
-        push_back(value);
-        return;
-    }
+    splice(pos, other, it);
+}
 
-    if (it == begin())
-    {
-        push_front(value);
-        return;
-    }
+template <typename T, typename Alloc>
+void List<T, Alloc>::splice(const iterator& pos, List<T, Alloc>& other, const iterator& first, const iterator& last)
+{
+    LIST_CHECK(pos.list_ == this && first.list_ == &other && last.list_ == &other,
+               "Iterator does not belong to this list");
+    NodeBase* from = first.current;
+    NodeBase* to = last.current;
+    if (from == to) return;
 
-    Node* newNode = new Node(value);
-    Node* currentNode = it.get_current();
+    NodeBase* position = pos.current;
+    NodeBase* back = to->previous;
+    if (&other == this && to == position) return;
 
-    if (!currentNode)
+    if (&other != this)
     {
-        return;
+        std::size_t count = 1;
+        for (NodeBase* node = from; node != back; node = node->next) ++count;
+        other.size_ -= count;
+        size_ += count;
     }
+    unlinkRange(from, back);
+    linkRange(position, from, back);
+}
 
-    newNode->next = currentNode;
-    newNode->previous = currentNode->previous;
+template <typename T, typename Alloc>
+void List<T, Alloc>::splice(const iterator& pos, List<T, Alloc>&& other, const iterator& first, const iterator& last)
+{
+    splice(pos, other, first, last);
+}
 
-    if (currentNode->previous)
-    {
-        currentNode->previous->next = newNode;
-    }
-    else
-    {
-        head = newNode;
-    }
+template <typename T, typename Alloc>
+T* List<T, Alloc>::iterator::operator->() const
+{
+    return &**this;
+}
 
-    currentNode->previous = newNode;
-    size_++;
+template <typename T, typename Alloc>
+const T* List<T, Alloc>::const_iterator::operator->() const
+{
+    return &**this;
 }
 
-template <typename T>
-void List<T>::erase(const List<T>::iterator& it)
+template <typename T, typename Alloc>
+typename List<T, Alloc>::iterator List<T, Alloc>::insert(const iterator& it, const T& value)
 {
-    Node* currentNode = it.get_current();
+    return emplace(it, value);
+}
 
-    if (!currentNode)
-    {
-        return;
-    }
+template <typename T, typename Alloc>
+typename List<T, Alloc>::iterator List<T, Alloc>::insert(const iterator& it, T&& value)
+{
+    return emplace(it, std::move(value));
+}
 
-    if (it == end())
-    {
-        pop_back();
-        return;
-    }
+template <typename T, typename Alloc>
+template <typename... Args>
+typename List<T, Alloc>::iterator List<T, Alloc>::emplace(const iterator& it, Args&&... args)
+{
+    LIST_CHECK(it.list_ == this, "Iterator does not belong to this list");
+    Node* newNode = createNode(std::forward<Args>(args)...);
+    linkRange(it.current, newNode, newNode);
+    ++size_;
+    return iterator(newNode, this);
+}
 
-    if (it == begin())
-    {
-        pop_front();
-        return;
-    }
+template <typename T, typename Alloc>
+void List<T, Alloc>::erase(const List<T, Alloc>::iterator& it)
+{
+    LIST_CHECK(it.list_ == this, "Iterator does not belong to this list");
+    NodeBase* currentNode = it.current;
+    if (currentNode == &sentinel_) return;
 
-    if (currentNode->previous)
-    {
-        currentNode->previous->next = currentNode->next;
-    }
-    if (currentNode->next)
-    {
-        currentNode->next->previous = currentNode->previous;
-    }
-    delete currentNode;
-    size_--;
+    unlinkRange(currentNode, currentNode);
+    destroyNode(static_cast<Node*>(currentNode));
+    --size_;
 }
 
-template <typename T>
+template <typename T, typename Alloc>
 template <typename inputIt>
-List<T>::List(inputIt begin, inputIt end) : head(nullptr), tail(nullptr), size_(0)
+List<T, Alloc>::List(inputIt begin, inputIt end, const Alloc& alloc) : alloc_(alloc)
 {
     while (begin != end)
     {
@@ -379,8 +538,8 @@ List<T>::List(inputIt begin, inputIt end) : head(nullptr), tail(nullptr), size_(
     }
 }
 
-template <typename T>
-List<T>::List(std::initializer_list<T> init) : head(nullptr), tail(nullptr), size_(0)
+template <typename T, typename Alloc>
+List<T, Alloc>::List(std::initializer_list<T> init, const Alloc& alloc) : alloc_(alloc)
 {
     for (auto it = init.begin(); it != init.end(); it++)
     {
@@ -388,433 +547,433 @@ List<T>::List(std::initializer_list<T> init) : head(nullptr), tail(nullptr), siz
     }
 }
 
-template <typename T>
-const T& List<T>::const_reverse_iterator::operator*()
+template <typename T, typename Alloc>
+const T& List<T, Alloc>::const_reverse_iterator::operator*() const
 {
-    if (current)
-        return current.value()->data;
-    else
-        throw std::bad_optional_access();
+    LIST_CHECK(list_ && current != &list_->sentinel_, "Dereferencing invalid iterator");
+    return static_cast<const Node*>(current)->data;
 }
 
-template <typename T>
-bool List<T>::const_reverse_iterator::operator==(const const_reverse_iterator& right)
+template <typename T, typename Alloc>
+bool List<T, Alloc>::const_reverse_iterator::operator==(const const_reverse_iterator& right) const
 {
     return current == right.current;
 }
 
-template <typename T>
-bool List<T>::const_reverse_iterator::operator!=(const const_reverse_iterator& right)
+template <typename T, typename Alloc>
+bool List<T, Alloc>::const_reverse_iterator::operator!=(const const_reverse_iterator& right) const
 {
     return !(*this == right);
 }
 
-template <typename T>
-typename List<T>::const_reverse_iterator& List<T>::const_reverse_iterator::operator--()
+template <typename T, typename Alloc>
+typename List<T, Alloc>::const_reverse_iterator& List<T, Alloc>::const_reverse_iterator::operator--()
 {
-    if (!current)
-    {
-        current = std::optional<Node*>(list_->head);
-    }
-    else
-    {
-        Node* nextNode = current.value()->next;
-        if (nextNode)
-            current = std::optional<Node*>(nextNode);
-        else
-            current = std::nullopt;
-    }
+    current = current->next;
     return *this;
 }
 
-template <typename T>
-typename List<T>::const_reverse_iterator List<T>::const_reverse_iterator::operator++(int)
+template <typename T, typename Alloc>
+typename List<T, Alloc>::const_reverse_iterator List<T, Alloc>::const_reverse_iterator::operator++(int)
 {
     const_reverse_iterator temp = *this;
     ++(*this);
     return temp;
 }
 
-template <typename T>
-typename List<T>::const_reverse_iterator& List<T>::const_reverse_iterator::operator++()
+template <typename T, typename Alloc>
+typename List<T, Alloc>::const_reverse_iterator& List<T, Alloc>::const_reverse_iterator::operator++()
 {
-    if (current)
-    {
-        Node* prevNode = current.value()->previous;
-        if (prevNode)
-            current = std::optional<Node*>(prevNode);
-        else
-            current = std::nullopt;
-    }
+    current = current->previous;
     return *this;
 }
 
-template <typename T>
-typename List<T>::const_reverse_iterator List<T>::const_reverse_iterator::operator--(int)
+template <typename T, typename Alloc>
+typename List<T, Alloc>::const_reverse_iterator List<T, Alloc>::const_reverse_iterator::operator--(int)
 {
     const_reverse_iterator temp = *this;
     --(*this);
     return temp;
 }
 
-template <typename T>
-typename List<T>::const_reverse_iterator List<T>::crbegin() const
+template <typename T, typename Alloc>
+typename List<T, Alloc>::const_reverse_iterator List<T, Alloc>::crbegin() const
 {
-    return List<T>::const_reverse_iterator(this, tail);
+    return List<T, Alloc>::const_reverse_iterator(sentinel_.previous, this);
 }
 
-template <typename T>
-typename List<T>::const_reverse_iterator List<T>::crend() const
+template <typename T, typename Alloc>
+typename List<T, Alloc>::const_reverse_iterator List<T, Alloc>::crend() const
 {
-    return List<T>::const_reverse_iterator(this, std::nullopt);
+    return List<T, Alloc>::const_reverse_iterator(&sentinel_, this);
 }
 
-template <typename T>
-bool List<T>::const_iterator::operator==(const const_iterator& right)
+template <typename T, typename Alloc>
+bool List<T, Alloc>::const_iterator::operator==(const const_iterator& right) const
 {
     return current == right.current;
 }
 
-template <typename T>
-bool List<T>::const_iterator::operator==(const iterator& right)
+template <typename T, typename Alloc>
+bool List<T, Alloc>::const_iterator::operator==(const iterator& right) const
 {
-    return current == right.cur();
+    return current == right.current;
 }
 
-template <typename T>
-bool List<T>::const_iterator::operator!=(const iterator& right)
+template <typename T, typename Alloc>
+bool List<T, Alloc>::const_iterator::operator!=(const iterator& right) const
 {
     return !(*this == right);
 }
 
-template <typename T>
-bool List<T>::const_iterator::operator!=(const const_iterator& right)
+template <typename T, typename Alloc>
+bool List<T, Alloc>::const_iterator::operator!=(const const_iterator& right) const
 {
     return !(*this == right);
 }
 
-template <typename T>
-const T& List<T>::const_iterator::operator*()
+template <typename T, typename Alloc>
+const T& List<T, Alloc>::const_iterator::operator*() const
 {
-    if (current)
-        return current.value()->data;
-    else
-        throw std::bad_optional_access();
+    LIST_CHECK(list_ && current != &list_->sentinel_, "Dereferencing invalid iterator");
+    return static_cast<const Node*>(current)->data;
 }
 
-template <typename T>
-typename List<T>::const_iterator List<T>::cbegin() const
+template <typename T, typename Alloc>
+typename List<T, Alloc>::const_iterator List<T, Alloc>::cbegin() const
 {
-    return const_iterator(this, head);
+    return const_iterator(sentinel_.next, this);
 }
 
-template <typename T>
-typename List<T>::const_iterator List<T>::cend() const
+template <typename T, typename Alloc>
+typename List<T, Alloc>::const_iterator List<T, Alloc>::cend() const
 {
-    // return const_iterator(this, head);
-    return const_iterator(this, std::nullopt);
+    return const_iterator(&sentinel_, this);
 }
 
-template <typename T>
-typename List<T>::const_iterator& List<T>::const_iterator::operator++()
+template <typename T, typename Alloc>
+typename List<T, Alloc>::const_iterator& List<T, Alloc>::const_iterator::operator++()
 {
-    if (current)
-    {
-        Node* nextNode = current.value()->next;
-        if (nextNode)
-            current = std::optional<Node*>(nextNode);
-        else
-            current = std::nullopt;
-    }
+    current = current->next;
     return *this;
 }
 
-template <typename T>
-typename List<T>::const_iterator List<T>::const_iterator::operator++(int)
+template <typename T, typename Alloc>
+typename List<T, Alloc>::const_iterator List<T, Alloc>::const_iterator::operator++(int)
 {
     const_iterator temp = *this;
     ++(*this);
     return temp;
 }
 
-template <typename T>
-typename List<T>::const_iterator& List<T>::const_iterator::operator--()
+template <typename T, typename Alloc>
+typename List<T, Alloc>::const_iterator& List<T, Alloc>::const_iterator::operator--()
 {
-    if (!current)
-    {
-        current = std::optional<Node*>(list_->tail);
-    }
-    else
-    {
-        Node* prevNode = current.value()->previous;
-        if (prevNode)
-            current = std::optional<Node*>(prevNode);
-        else
-            current = std::nullopt;
-    }
+    current = current->previous;
     return *this;
 }
 
-template <typename T>
-typename List<T>::const_iterator List<T>::const_iterator::operator--(int)
+template <typename T, typename Alloc>
+typename List<T, Alloc>::const_iterator List<T, Alloc>::const_iterator::operator--(int)
 {
     const_iterator temp = *this;
     --(*this);
     return temp;
 }
 
-template <typename T>
-T& List<T>::reverse_iterator::operator*()
+template <typename T, typename Alloc>
+T& List<T, Alloc>::reverse_iterator::operator*() const
 {
-    if (current)
-        return current.value()->data;
-    else
-        throw std::bad_optional_access();
+    LIST_CHECK(list_ && current != &list_->sentinel_, "Dereferencing invalid iterator");
+    return valueOf(current);
 }
 
-template <typename T>
-bool List<T>::reverse_iterator::operator==(const reverse_iterator& right)
+template <typename T, typename Alloc>
+bool List<T, Alloc>::reverse_iterator::operator==(const reverse_iterator& right) const
 {
     return current == right.current;
 }
 
-template <typename T>
-bool List<T>::reverse_iterator::operator!=(const reverse_iterator& right)
+template <typename T, typename Alloc>
+bool List<T, Alloc>::reverse_iterator::operator!=(const reverse_iterator& right) const
 {
     return !(*this == right);
 }
 
-template <typename T>
-typename List<T>::reverse_iterator& List<T>::reverse_iterator::operator--()
+template <typename T, typename Alloc>
+typename List<T, Alloc>::reverse_iterator& List<T, Alloc>::reverse_iterator::operator--()
 {
-    if (!current)
-    {
-        current = std::optional<Node*>(list_->head);
-    }
-    else
-    {
-        Node* nextNode = current.value()->next;
-        if (nextNode)
-            current = std::optional<Node*>(nextNode);
-        else
-            current = std::nullopt;
-    }
+    current = current->next;
     return *this;
 }
 
-template <typename T>
-typename List<T>::reverse_iterator List<T>::reverse_iterator::operator++(int)
+template <typename T, typename Alloc>
+typename List<T, Alloc>::reverse_iterator List<T, Alloc>::reverse_iterator::operator++(int)
 {
     reverse_iterator temp = *this;
     ++(*this);
     return temp;
 }
 
-template <typename T>
-typename List<T>::reverse_iterator& List<T>::reverse_iterator::operator++()
+template <typename T, typename Alloc>
+typename List<T, Alloc>::reverse_iterator& List<T, Alloc>::reverse_iterator::operator++()
 {
-    if (current)
-    {
-        Node* prevNode = current.value()->previous;
-        if (prevNode)
-            current = std::optional<Node*>(prevNode);
-        else
-            current = std::nullopt;
-    }
+    current = current->previous;
     return *this;
 }
 
-template <typename T>
-typename List<T>::reverse_iterator List<T>::reverse_iterator::operator--(int)
+template <typename T, typename Alloc>
+typename List<T, Alloc>::reverse_iterator List<T, Alloc>::reverse_iterator::operator--(int)
 {
     reverse_iterator temp = *this;
     --(*this);
     return temp;
 }
 
-template <typename T>
-typename List<T>::reverse_iterator List<T>::rbegin()
+template <typename T, typename Alloc>
+typename List<T, Alloc>::reverse_iterator List<T, Alloc>::rbegin()
 {
-    return List<T>::reverse_iterator(this, tail);
+    return List<T, Alloc>::reverse_iterator(sentinel_.previous, this);
 }
 
-template <typename T>
-typename List<T>::reverse_iterator List<T>::rend()
+template <typename T, typename Alloc>
+typename List<T, Alloc>::reverse_iterator List<T, Alloc>::rend()
 {
-    return List<T>::reverse_iterator(this, std::nullopt);
+    return List<T, Alloc>::reverse_iterator(&sentinel_, this);
 }
 
-template <typename T>
-T& List<T>::iterator::operator*()
+template <typename T, typename Alloc>
+T& List<T, Alloc>::iterator::operator*() const
 {
-    if (current)
-        return current.value()->data;
-    else
-        throw std::bad_optional_access();
+    LIST_CHECK(list_ && current != &list_->sentinel_, "Dereferencing invalid iterator");
+    return valueOf(current);
 }
 
-template <typename T>
-bool List<T>::iterator::operator==(const iterator& right)
+template <typename T, typename Alloc>
+bool List<T, Alloc>::iterator::operator==(const iterator& right) const
 {
     return current == right.current;
 }
 
-template <typename T>
-bool List<T>::iterator::operator==(const iterator& right) const
-{
-    return current == right.current;
-}
-
-template <typename T>
-bool List<T>::iterator::operator!=(const iterator& right)
+template <typename T, typename Alloc>
+bool List<T, Alloc>::iterator::operator!=(const iterator& right) const
 {
     return !(*this == right);
 }
 
-template <typename T>
-typename List<T>::iterator& List<T>::iterator::operator++()
+template <typename T, typename Alloc>
+typename List<T, Alloc>::iterator& List<T, Alloc>::iterator::operator++()
 {
-    if (current)
-    {
-        Node* nextNode = current.value()->next;
-        if (nextNode)
-            current = std::optional<Node*>(nextNode);
-        else
-            current = std::nullopt;
-    }
+    current = current->next;
     return *this;
 }
 
-template <typename T>
-typename List<T>::iterator List<T>::iterator::operator++(int)
+template <typename T, typename Alloc>
+typename List<T, Alloc>::iterator List<T, Alloc>::iterator::operator++(int)
 {
     iterator temp = *this;
     ++(*this);
     return temp;
 }
 
-template <typename T>
-typename List<T>::iterator& List<T>::iterator::operator--()
+template <typename T, typename Alloc>
+typename List<T, Alloc>::iterator& List<T, Alloc>::iterator::operator--()
 {
-    if (!current)
-    {
-        current = std::optional<Node*>(list_->tail);
-    }
-    else
-    {
-        Node* prevNode = current.value()->previous;
-        if (prevNode)
-            current = std::optional<Node*>(prevNode);
-        else
-            current = std::nullopt;
-    }
+    current = current->previous;
     return *this;
 }
 
-template <typename T>
-typename List<T>::iterator List<T>::iterator::operator--(int)
+template <typename T, typename Alloc>
+typename List<T, Alloc>::iterator List<T, Alloc>::iterator::operator--(int)
 {
     iterator temp = *this;
     --(*this);
     return temp;
 }
 
-template <typename T>
-typename List<T>::iterator List<T>::begin()
+template <typename T, typename Alloc>
+typename List<T, Alloc>::iterator List<T, Alloc>::begin()
 {
-    return List<T>::iterator(this, head);
+    return List<T, Alloc>::iterator(sentinel_.next, this);
 }
 
-template <typename T>
-typename List<T>::iterator List<T>::end()
+template <typename T, typename Alloc>
+typename List<T, Alloc>::iterator List<T, Alloc>::end()
 {
-    return List<T>::iterator(this, std::nullopt);
+    return List<T, Alloc>::iterator(&sentinel_, this);
 }
 
-template <typename T>
-typename List<T>::const_iterator List<T>::begin() const
+template <typename T, typename Alloc>
+typename List<T, Alloc>::const_iterator List<T, Alloc>::begin() const
 {
-    return List<T>::const_iterator(this, head);
+    return List<T, Alloc>::const_iterator(sentinel_.next, this);
 }
 
-template <typename T>
-typename List<T>::iterator List<T>::end() const
+template <typename T, typename Alloc>
+typename List<T, Alloc>::const_iterator List<T, Alloc>::end() const
 {
-    return List<T>::iterator(this, std::nullopt);
+    return List<T, Alloc>::const_iterator(&sentinel_, this);
 }
 
-template <typename T>
-typename List<T>::iterator List<T>::before_begin()
+template <typename T, typename Alloc>
+typename List<T, Alloc>::iterator List<T, Alloc>::before_begin()
 {
-    return List<T>::iterator(this, std::nullopt);
+    return List<T, Alloc>::iterator(&sentinel_, this);
 }
 
-template <typename T>
-List<T>& List<T>::operator=(const List<T>& right)
+template <typename T, typename Alloc>
+List<T, Alloc>& List<T, Alloc>::operator=(const List<T, Alloc>& right)
 {
     if (this == &right) return *this;
     clear();
+    if constexpr (node_traits::propagate_on_container_copy_assignment::value) alloc_ = right.alloc_;
 
-    Node* element = right.head;
-    while (element)
+    for (const NodeBase* element = right.sentinel_.next; element != &right.sentinel_; element = element->next)
     {
-        push_back(element->data);
-        element = element->next;
+        push_back(static_cast<const Node*>(element)->data);
     }
     return *this;
 }
 
-template <typename T>
-bool List<T>::operator==(const List<T>& right)
+template <typename T, typename Alloc>
+bool List<T, Alloc>::operator==(const List<T, Alloc>& right) const
 {
-    Node* l = this->head;
-    Node* r = right.head;
-    while (l && r)
+    if (size_ != right.size_) return false;
+    const NodeBase* l = sentinel_.next;
+    const NodeBase* r = right.sentinel_.next;
+    for (; l != &sentinel_; l = l->next, r = r->next)
     {
-        if (l->data != r->data) return false;
-        l = l->next;
-        r = r->next;
+        if (static_cast<const Node*>(l)->data != static_cast<const Node*>(r)->data) return false;
     }
-    return l == nullptr && r == nullptr;
+    return true;
 }
 
-template <typename T>
-bool List<T>::operator!=(const List<T>& right)
+template <typename T, typename Alloc>
+bool List<T, Alloc>::operator!=(const List<T, Alloc>& right) const
 {
     return !(*this == right);
 }
 
-template <typename T>
-List<T>::List(const List<T>& copy)
+template <typename T, typename Alloc>
+List<T, Alloc>::List(const List<T, Alloc>& copy)
+    : alloc_(node_traits::select_on_container_copy_construction(copy.alloc_))
+{
+    for (const NodeBase* element = copy.sentinel_.next; element != &copy.sentinel_; element = element->next)
+    {
+        push_back(static_cast<const Node*>(element)->data);
+    }
+}
+
+template <typename T, typename Alloc>
+List<T, Alloc>::List(List<T, Alloc>&& other) noexcept : alloc_(std::move(other.alloc_))
+{
+    stealNodes(other);
+}
+
+template <typename T, typename Alloc>
+List<T, Alloc>::List(List<T, Alloc>&& other, const Alloc& alloc) : alloc_(alloc)
+{
+    if (alloc_ == other.alloc_)
+    {
+        stealNodes(other);
+        return;
+    }
+    for (NodeBase* element = other.sentinel_.next; element != &other.sentinel_; element = element->next)
+    {
+        emplace_back(std::move(valueOf(element)));
+    }
+    other.clear();
+}
+
+template <typename T, typename Alloc>
+List<T, Alloc>& List<T, Alloc>::operator=(List<T, Alloc>&& right) noexcept(
+    node_traits::propagate_on_container_move_assignment::value || node_traits::is_always_equal::value)
+{
+    if (this == &right) return *this;
+    clear();
+    if constexpr (node_traits::propagate_on_container_move_assignment::value)
+    {
+        alloc_ = std::move(right.alloc_);
+    }
+    else if (alloc_ != right.alloc_)
+    {
+        // our allocator cannot free right's nodes: move the elements into nodes of our own
+        for (NodeBase* element = right.sentinel_.next; element != &right.sentinel_; element = element->next)
+        {
+            emplace_back(std::move(valueOf(element)));
+        }
+        right.clear();
+        return *this;
+    }
+    stealNodes(right);
+    return *this;
+}
+
+template <typename T, typename Alloc>
+void List<T, Alloc>::adoptRing() noexcept
+{
+    if (size_ == 0)
+    {
+        sentinel_.next = sentinel_.previous = &sentinel_;
+        return;
+    }
+    sentinel_.next->previous = &sentinel_;
+    sentinel_.previous->next = &sentinel_;
+}
+
+template <typename T, typename Alloc>
+void List<T, Alloc>::stealNodes(List<T, Alloc>& other) noexcept
 {
-    Node* element = copy.head;
-    while (element)
+    sentinel_ = other.sentinel_;
+    size_ = other.size_;
+    adoptRing();
+    other.sentinel_.next = other.sentinel_.previous = &other.sentinel_;
+    other.size_ = 0;
+}
+
+template <typename T, typename Alloc>
+void List<T, Alloc>::swap(List<T, Alloc>& other) noexcept
+{
+    if (this == &other) return;
+    if constexpr (node_traits::propagate_on_container_swap::value)
     {
-        push_back(element->data);
-        element = element->next;
+        using std::swap;
+        swap(alloc_, other.alloc_);
     }
+    std::swap(sentinel_, other.sentinel_);
+    std::swap(size_, other.size_);
+    adoptRing();
+    other.adoptRing();
 }
 
-template <typename T>
-void List<T>::clear()
+template <typename T, typename Alloc>
+void List<T, Alloc>::clear()
 {
-    while (size_) pop_front();
+    NodeBase* node = sentinel_.next;
+    while (node != &sentinel_)
+    {
+        NodeBase* next = node->next;
+        destroyNode(static_cast<Node*>(node));
+        node = next;
+    }
+    sentinel_.next = sentinel_.previous = &sentinel_;
+    size_ = 0;
 }
 
-template <typename T>
-List<T>::~List()
+template <typename T, typename Alloc>
+List<T, Alloc>::~List()
 {
     clear();
 }
 
-template <typename T>
-std::size_t List<T>::size() const noexcept
+template <typename T, typename Alloc>
+std::size_t List<T, Alloc>::size() const noexcept
 {
     return size_;
 }
 
-template <typename T>
-List<T>::List(int size, const T& value) : head(nullptr), tail(nullptr), size_(0)
+template <typename T, typename Alloc>
+List<T, Alloc>::List(int size, const T& value, const Alloc& alloc) : alloc_(alloc)
 {
     for (std::size_t i = 0; i < size; ++i)
     {
@@ -822,121 +981,155 @@ List<T>::List(int size, const T& value) : head(nullptr), tail(nullptr), size_(0)
     }
 }
 
-template <typename T>
-const T& List<T>::front() const
+template <typename T, typename Alloc>
+const T& List<T, Alloc>::front() const
 {
-    return head->data;
+    LIST_CHECK(size_ != 0, "List is empty");
+    return static_cast<const Node*>(sentinel_.next)->data;
 }
 
-template <typename T>
-T& List<T>::front()
+template <typename T, typename Alloc>
+T& List<T, Alloc>::front()
 {
-    return head->data;
+    LIST_CHECK(size_ != 0, "List is empty");
+    return valueOf(sentinel_.next);
 }
 
-template <typename T>
-const T& List<T>::back() const
+template <typename T, typename Alloc>
+const T& List<T, Alloc>::back() const
 {
-    return tail->data;
+    LIST_CHECK(size_ != 0, "List is empty");
+    return static_cast<const Node*>(sentinel_.previous)->data;
 }
 
-template <typename T>
-T& List<T>::back()
+template <typename T, typename Alloc>
+T& List<T, Alloc>::back()
 {
-    return tail->data;
+    LIST_CHECK(size_ != 0, "List is empty");
+    return valueOf(sentinel_.previous);
 }
 
-template <typename T>
-void List<T>::pop_front()
+template <typename T, typename Alloc>
+void List<T, Alloc>::pop_front()
 {
-    if (!head) return;
-    Node* old = head;
-    head = head->next;
-    if (head)
-    {
-        head->previous = nullptr;
-    }
-    else
-    {
-        tail = nullptr;
-    }
-    delete old;
+    if (!size_) return;
+    NodeBase* old = sentinel_.next;
+    unlinkRange(old, old);
+    destroyNode(static_cast<Node*>(old));
     --size_;
 }
 
-template <typename T>
-void List<T>::pop_back()
+template <typename T, typename Alloc>
+void List<T, Alloc>::pop_back()
 {
-    if (!tail) return;
-    Node* old = tail;
-    tail = tail->previous;
-    if (tail)
-    {
-        tail->next = nullptr;
-    }
-    else
-    {
-        head = nullptr;
-    }
-    delete old;
+    if (!size_) return;
+    NodeBase* old = sentinel_.previous;
+    unlinkRange(old, old);
+    destroyNode(static_cast<Node*>(old));
     --size_;
 }
 
-template <typename T>
-void List<T>::push_back(const T& value)
+template <typename T, typename Alloc>
+void List<T, Alloc>::push_back(const T& value)
 {
-    Node* newNode = new Node(value);
-    if (!tail)
-    {
-        head = tail = newNode;
-    }
-    else
-    {
-        tail->next = newNode;
-        newNode->previous = tail;
-        tail = newNode;
-    }
+    emplace_back(value);
+}
+
+template <typename T, typename Alloc>
+void List<T, Alloc>::push_back(T&& value)
+{
+    emplace_back(std::move(value));
+}
+
+template <typename T, typename Alloc>
+void List<T, Alloc>::push_front(const T& value)
+{
+    emplace_front(value);
+}
+
+template <typename T, typename Alloc>
+void List<T, Alloc>::push_front(T&& value)
+{
+    emplace_front(std::move(value));
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+T& List<T, Alloc>::emplace_back(Args&&... args)
+{
+    Node* newNode = createNode(std::forward<Args>(args)...);
+    linkRange(&sentinel_, newNode, newNode);
+    ++size_;
+    return newNode->data;
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+T& List<T, Alloc>::emplace_front(Args&&... args)
+{
+    Node* newNode = createNode(std::forward<Args>(args)...);
+    linkRange(sentinel_.next, newNode, newNode);
     ++size_;
+    return newNode->data;
 }
 
-template <typename T>
-void List<T>::push_front(const T& value)
+template <typename T, typename Alloc>
+template <typename... Args>
+typename List<T, Alloc>::Node* List<T, Alloc>::createNode(Args&&... args)
 {
-    Node* newNode = new Node(value);
-    if (!head)
+    Node* node = node_traits::allocate(alloc_, 1);
+    try
     {
-        head = tail = newNode;
+        node_traits::construct(alloc_, node, std::forward<Args>(args)...);
     }
-    else
+    catch (...)
     {
-        newNode->next = head;
-        head->previous = newNode;
-        head = newNode;
+        node_traits::deallocate(alloc_, node, 1);
+        throw;
     }
-    ++size_;
+    return node;
+}
+
+template <typename T, typename Alloc>
+void List<T, Alloc>::destroyNode(Node* node) noexcept
+{
+    node_traits::destroy(alloc_, node);
+    node_traits::deallocate(alloc_, node, 1);
+}
+
+template <typename T, typename Alloc>
+typename List<T, Alloc>::allocator_type List<T, Alloc>::get_allocator() const noexcept
+{
+    return Alloc(alloc_);
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+List<T, Alloc>::Node::Node(Args&&... args) : NodeBase{nullptr, nullptr}, data(std::forward<Args>(args)...)
+{
 }
 
-template <typename T>
-List<T>::Node::Node(const T& value) : data(value), next(nullptr), previous(nullptr)
+template <typename T, typename Alloc>
+List<T, Alloc>::List() : List(Alloc())
 {
 }
 
-template <typename T>
-List<T>::List() : head(nullptr), tail(nullptr), size_(0)
+template <typename T, typename Alloc>
+List<T, Alloc>::List(const Alloc& alloc) : alloc_(alloc)
 {
 }
 
-template <typename T>
-List<T>::List(std::size_t size) : head(nullptr), tail(nullptr), size_(0)
+template <typename T, typename Alloc>
+List<T, Alloc>::List(std::size_t size, const Alloc& alloc) : alloc_(alloc)
 {
     for (std::size_t i = 0; i < size; ++i)
     {
-        push_back(T());
+        emplace_back();
     }
 }
 
-template <typename T>
-bool List<T>::empty() const noexcept
+template <typename T, typename Alloc>
+bool List<T, Alloc>::empty() const noexcept
 {
     return size_ == 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdexcept>
+
+// Define LIST_DEBUG to check the preconditions of the linked lists at run time: List
+// iterators remember their list and every dereference and every position passed to insert,
+// erase and splice is checked; IntrusiveList checks that elements are linked or unlinked
+// as required. Off by default, when the checks compile to nothing.
+#ifdef LIST_DEBUG
+#define LIST_CHECK(condition, message)                       \
+    do                                                       \
+    {                                                        \
+        if (!(condition)) throw std::runtime_error(message); \
+    } while (0)
+#else
+#define LIST_CHECK(condition, message) \
+    do                                 \
+    {                                  \
+    } while (0)
+#endif
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+// Allocator backed by malloc/realloc/free. Besides the standard interface it
+// exposes reallocate(), which Vector uses to grow buffers of trivially
+// relocatable elements in place; for large blocks glibc's realloc resizes the
+// mapping with mremap instead of copying.
+template <typename T>
+class MallocAllocator
+{
+   private:
+    static_assert(alignof(T) <= alignof(std::max_align_t), "MallocAllocator cannot satisfy over-aligned types");
+
+    static std::size_t bytes(std::size_t count)
+    {
+        if (count > std::numeric_limits<std::size_t>::max() / sizeof(T)) throw std::bad_array_new_length();
+        return count * sizeof(T);
+    }
+
+   public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    MallocAllocator() noexcept = default;
+
+    template <typename U>
+    MallocAllocator(const MallocAllocator<U>&) noexcept
+    {
+    }
+
+    T* allocate(std::size_t count)
+    {
+        void* pointer = std::malloc(bytes(count));
+        if (!pointer) throw std::bad_alloc();
+        return static_cast<T*>(pointer);
+    }
+
+    // the contents are carried over bytewise, so only valid for trivially relocatable T
+    T* reallocate(T* pointer, std::size_t, std::size_t new_count)
+    {
+        void* result = std::realloc(pointer, bytes(new_count));
+        if (!result) throw std::bad_alloc();
+        return static_cast<T*>(result);
+    }
+
+    void deallocate(T* pointer, std::size_t) noexcept { std::free(pointer); }
+
+    template <typename U>
+    bool operator==(const MallocAllocator<U>&) const noexcept
+    {
+        return true;
+    }
+};
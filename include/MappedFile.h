@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// A file mapped read-write into memory (MAP_SHARED), so stores land in the page
+// cache and reach the file without explicit writes. resize() changes the file
+// length with ftruncate and the mapping with mremap, which may move it: pointers
+// into data() do not survive a resize. Failing system calls throw std::system_error.
+class MappedFile
+{
+   private:
+    int fd_;
+    void* data_;
+    std::size_t size_;
+
+    void unmap() noexcept;
+
+   public:
+    // opens path, creating an empty file if there is none, and maps all of it
+    explicit MappedFile(const std::string& path);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    // nullptr while the file is empty
+    void* data() const noexcept;
+    std::size_t size() const noexcept;
+
+    void resize(std::size_t bytes);
+
+    // block until dirty pages are written back to the file
+    void sync();
+
+    void swap(MappedFile& other) noexcept;
+};
@@ -0,0 +1,545 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "GrowthPolicy.h"
+#include "MappedFile.h"
+#include "Simd.h"
+
+// Vector whose elements live in a memory-mapped file, laid out as a 64-byte
+// header (magic, element size, element count) followed by the raw elements.
+// Reopening the file gives back the previous contents with no parsing or
+// copying; only pages that are actually read get faulted in.
+//
+// Elements are stored as raw bytes, so T must be trivially copyable and must
+// not hold pointers meant to outlive the process. Growth extends the file with
+// ftruncate and remaps it, which may move the mapping: like reallocation in
+// Vector, this invalidates pointers and iterators.
+template <typename T, typename Growth = PowerOfTwoGrowth>
+class MappedVector
+{
+    static_assert(std::is_trivially_copyable_v<T>, "MappedVector stores elements as raw bytes");
+    static_assert(alignof(T) <= 64, "elements must fit the alignment of the 64-byte header");
+
+   public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    // opens the file at path, creating it if it does not exist; throws std::system_error if
+    // the file cannot be opened or mapped and std::runtime_error if it holds something else
+    explicit MappedVector(const std::string& path);
+    MappedVector(const MappedVector&) = delete;
+    // a moved-from MappedVector may only be destroyed or assigned to
+    MappedVector(MappedVector&& other) noexcept = default;
+
+    void clear();
+    bool empty() const noexcept;
+    size_t size() const noexcept;
+    size_t capacity() const noexcept;
+
+    T& at(size_t index);
+    const T& at(size_t index) const;
+
+    T& front();
+    const T& front() const;
+
+    T& back();
+    const T& back() const;
+
+    T* data() noexcept;
+    const T* data() const noexcept;
+
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    MappedVector& push_back(const T& value);
+    void pop_back();
+
+    // grows the file; shrink_to_fit truncates it to the current size
+    void reserve(size_t capacity);
+    void shrink_to_fit();
+
+    void swap(MappedVector& other) noexcept;
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args);
+
+    void resize(size_t count);
+    void resize(size_t count, const T& value);
+    void resize_uninitialized(size_t count);
+
+    void assign(size_t count, const T& value);
+    template <std::input_iterator InputIt>
+    void assign(InputIt first, InputIt last);
+    void assign(std::initializer_list<T> init);
+
+    iterator insert(const_iterator pos, const T& value);
+    iterator insert(const_iterator pos, size_t count, const T& value);
+    template <std::input_iterator InputIt>
+    iterator insert(const_iterator pos, InputIt first, InputIt last);
+    iterator insert(const_iterator pos, std::initializer_list<T> init);
+
+    template <std::input_iterator InputIt>
+    void append(InputIt first, InputIt last);
+    template <std::ranges::input_range Range>
+    void append(Range&& range);
+
+    void fill(const T& value);
+    iterator find(const T& value);
+    const_iterator find(const T& value) const;
+    size_t count(const T& value) const;
+    T min() const;
+    T max() const;
+
+    // flush the contents to disk; without it they still reach the file, just not on a schedule
+    void sync();
+
+   public:
+    T& operator[](size_t index);
+    const T& operator[](size_t index) const;
+    bool operator==(const MappedVector& other) const;
+    bool operator!=(const MappedVector& other) const;
+    MappedVector& operator=(const MappedVector&) = delete;
+    MappedVector& operator=(MappedVector&& other) noexcept = default;
+
+   private:
+    struct Header
+    {
+        std::uint64_t magic;
+        std::uint64_t element_size;
+        std::uint64_t size;
+        std::uint64_t reserved[5];
+    };
+    static_assert(sizeof(Header) == 64);
+
+    static constexpr std::uint64_t file_magic = 0x31524f5443455644;  // "DVECTOR1"
+
+    Header* header() const noexcept;
+    T* array() const noexcept;
+
+    // remap the file to hold exactly capacity elements
+    void reallocate(size_t capacity);
+    size_t grow_capacity(size_t required) const;
+
+    // open a gap of count elements at index, reallocating if needed
+    T* make_gap(size_t index, size_t count);
+
+   private:
+    MappedFile file_;
+};
+
+template <typename T, typename Growth>
+MappedVector<T, Growth>::MappedVector(const std::string& path) : file_(path)
+{
+    if (file_.size() == 0)
+    {
+        file_.resize(sizeof(Header));
+        *header() = Header{file_magic, sizeof(T), 0, {}};
+        return;
+    }
+
+    if (file_.size() < sizeof(Header) || header()->magic != file_magic)
+        throw std::runtime_error(path + ": not a MappedVector file");
+    if (header()->element_size != sizeof(T)) throw std::runtime_error(path + ": element size mismatch");
+    if (header()->size > capacity()) throw std::runtime_error(path + ": truncated file");
+}
+
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::Header* MappedVector<T, Growth>::header() const noexcept
+{
+    return static_cast<Header*>(file_.data());
+}
+
+template <typename T, typename Growth>
+T* MappedVector<T, Growth>::array() const noexcept
+{
+    return reinterpret_cast<T*>(static_cast<char*>(file_.data()) + sizeof(Header));
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::reallocate(size_t new_capacity)
+{
+    file_.resize(sizeof(Header) + new_capacity * sizeof(T));
+}
+
+template <typename T, typename Growth>
+size_t MappedVector<T, Growth>::grow_capacity(size_t required) const
+{
+    return Growth::next_capacity(capacity(), required, sizeof(T));
+}
+
+template <typename T, typename Growth>
+T* MappedVector<T, Growth>::make_gap(size_t index, size_t count)
+{
+    size_t size = header()->size;
+    if (size + count > capacity()) reallocate(grow_capacity(size + count));
+    T* position = array() + index;
+    std::memmove(position + count, position, (size - index) * sizeof(T));
+    header()->size = size + count;
+    return position;
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::clear()
+{
+    header()->size = 0;
+}
+
+template <typename T, typename Growth>
+bool MappedVector<T, Growth>::empty() const noexcept
+{
+    return header()->size == 0;
+}
+
+template <typename T, typename Growth>
+size_t MappedVector<T, Growth>::size() const noexcept
+{
+    return header()->size;
+}
+
+template <typename T, typename Growth>
+size_t MappedVector<T, Growth>::capacity() const noexcept
+{
+    return (file_.size() - sizeof(Header)) / sizeof(T);
+}
+
+template <typename T, typename Growth>
+T& MappedVector<T, Growth>::at(size_t index)
+{
+    if (index >= size()) throw std::out_of_range("Index out of range");
+    return array()[index];
+}
+
+template <typename T, typename Growth>
+const T& MappedVector<T, Growth>::at(size_t index) const
+{
+    if (index >= size()) throw std::out_of_range("Index out of range");
+    return array()[index];
+}
+
+template <typename T, typename Growth>
+T& MappedVector<T, Growth>::front()
+{
+    if (empty()) throw std::runtime_error("Vector is empty");
+    return array()[0];
+}
+
+template <typename T, typename Growth>
+const T& MappedVector<T, Growth>::front() const
+{
+    if (empty()) throw std::runtime_error("Vector is empty");
+    return array()[0];
+}
+
+template <typename T, typename Growth>
+T& MappedVector<T, Growth>::back()
+{
+    if (empty()) throw std::runtime_error("Vector is empty");
+    return array()[size() - 1];
+}
+
+template <typename T, typename Growth>
+const T& MappedVector<T, Growth>::back() const
+{
+    if (empty()) throw std::runtime_error("Vector is empty");
+    return array()[size() - 1];
+}
+
+template <typename T, typename Growth>
+T* MappedVector<T, Growth>::data() noexcept
+{
+    return array();
+}
+
+template <typename T, typename Growth>
+const T* MappedVector<T, Growth>::data() const noexcept
+{
+    return array();
+}
+
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::iterator MappedVector<T, Growth>::begin() noexcept
+{
+    return array();
+}
+
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::const_iterator MappedVector<T, Growth>::begin() const noexcept
+{
+    return array();
+}
+
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::iterator MappedVector<T, Growth>::end() noexcept
+{
+    return array() + size();
+}
+
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::const_iterator MappedVector<T, Growth>::end() const noexcept
+{
+    return array() + size();
+}
+
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::const_iterator MappedVector<T, Growth>::cbegin() const noexcept
+{
+    return begin();
+}
+
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::const_iterator MappedVector<T, Growth>::cend() const noexcept
+{
+    return end();
+}
+
+template <typename T, typename Growth>
+MappedVector<T, Growth>& MappedVector<T, Growth>::push_back(const T& value)
+{
+    emplace_back(value);
+    return *this;
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::pop_back()
+{
+    if (empty()) throw std::runtime_error("Vector is empty");
+    header()->size--;
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::reserve(size_t new_capacity)
+{
+    if (new_capacity <= capacity()) return;
+    reallocate(new_capacity);
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::shrink_to_fit()
+{
+    if (size() < capacity()) reallocate(size());
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::swap(MappedVector& other) noexcept
+{
+    file_.swap(other.file_);
+}
+
+template <typename T, typename Growth>
+template <typename... Args>
+T& MappedVector<T, Growth>::emplace_back(Args&&... args)
+{
+    // build the element first: args may refer to an element that remapping would move
+    T value(std::forward<Args>(args)...);
+    size_t size = header()->size;
+    if (size == capacity()) reallocate(grow_capacity(size + 1));
+    array()[size] = value;
+    header()->size = size + 1;
+    return array()[size];
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::resize(size_t count)
+{
+    resize(count, T());
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::resize(size_t count, const T& value)
+{
+    size_t size = header()->size;
+    if (count <= size)
+    {
+        header()->size = count;
+        return;
+    }
+    insert(end(), count - size, value);
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::resize_uninitialized(size_t count)
+{
+    if (count > capacity()) reallocate(grow_capacity(count));
+    header()->size = count;
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::assign(size_t count, const T& value)
+{
+    T copy(value);
+    if (count > capacity()) reallocate(grow_capacity(count));
+    simd::fill(array(), count, copy);
+    header()->size = count;
+}
+
+template <typename T, typename Growth>
+template <std::input_iterator InputIt>
+void MappedVector<T, Growth>::assign(InputIt first, InputIt last)
+{
+    clear();
+    append(first, last);
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::assign(std::initializer_list<T> init)
+{
+    assign(init.begin(), init.end());
+}
+
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::iterator MappedVector<T, Growth>::insert(const_iterator pos, const T& value)
+{
+    return insert(pos, 1, value);
+}
+
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::iterator MappedVector<T, Growth>::insert(const_iterator pos, size_t count,
+                                                                           const T& value)
+{
+    T copy(value);
+    T* gap = make_gap(static_cast<size_t>(pos - array()), count);
+    simd::fill(gap, count, copy);
+    return gap;
+}
+
+template <typename T, typename Growth>
+template <std::input_iterator InputIt>
+typename MappedVector<T, Growth>::iterator MappedVector<T, Growth>::insert(const_iterator pos, InputIt first,
+                                                                           InputIt last)
+{
+    size_t index = static_cast<size_t>(pos - array());
+    if constexpr (std::forward_iterator<InputIt>)
+    {
+        size_t count = static_cast<size_t>(std::distance(first, last));
+        const T* source = nullptr;
+        if constexpr (std::contiguous_iterator<InputIt>)
+        {
+            source = std::to_address(first);
+        }
+        // the source may be part of this vector, which make_gap can move and shift
+        if (source && source + count > array() && source < array() + size())
+        {
+            std::vector<T> copy(source, source + count);
+            return insert(pos, copy.begin(), copy.end());
+        }
+
+        T* gap = make_gap(index, count);
+        std::copy(first, last, gap);
+        return gap;
+    }
+    else
+    {
+        size_t size = header()->size;
+        for (; first != last; ++first) emplace_back(*first);
+        std::rotate(array() + index, array() + size, array() + header()->size);
+        return array() + index;
+    }
+}
+
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::iterator MappedVector<T, Growth>::insert(const_iterator pos,
+                                                                           std::initializer_list<T> init)
+{
+    return insert(pos, init.begin(), init.end());
+}
+
+template <typename T, typename Growth>
+template <std::input_iterator InputIt>
+void MappedVector<T, Growth>::append(InputIt first, InputIt last)
+{
+    insert(end(), first, last);
+}
+
+template <typename T, typename Growth>
+template <std::ranges::input_range Range>
+void MappedVector<T, Growth>::append(Range&& range)
+{
+    append(std::ranges::begin(range), std::ranges::end(range));
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::fill(const T& value)
+{
+    T copy(value);
+    simd::fill(array(), size(), copy);
+}
+
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::iterator MappedVector<T, Growth>::find(const T& value)
+{
+    return array() + simd::find(static_cast<const T*>(array()), size(), value);
+}
+
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::const_iterator MappedVector<T, Growth>::find(const T& value) const
+{
+    return array() + simd::find(static_cast<const T*>(array()), size(), value);
+}
+
+template <typename T, typename Growth>
+size_t MappedVector<T, Growth>::count(const T& value) const
+{
+    return simd::count(static_cast<const T*>(array()), size(), value);
+}
+
+template <typename T, typename Growth>
+T MappedVector<T, Growth>::min() const
+{
+    if (empty()) throw std::runtime_error("Vector is empty");
+    return simd::min(static_cast<const T*>(array()), size());
+}
+
+template <typename T, typename Growth>
+T MappedVector<T, Growth>::max() const
+{
+    if (empty()) throw std::runtime_error("Vector is empty");
+    return simd::max(static_cast<const T*>(array()), size());
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::sync()
+{
+    file_.sync();
+}
+
+template <typename T, typename Growth>
+T& MappedVector<T, Growth>::operator[](size_t index)
+{
+    return array()[index];
+}
+
+template <typename T, typename Growth>
+const T& MappedVector<T, Growth>::operator[](size_t index) const
+{
+    return array()[index];
+}
+
+template <typename T, typename Growth>
+bool MappedVector<T, Growth>::operator==(const MappedVector& other) const
+{
+    if (size() != other.size()) return false;
+    return simd::equal(static_cast<const T*>(array()), static_cast<const T*>(other.array()), size());
+}
+
+template <typename T, typename Growth>
+bool MappedVector<T, Growth>::operator!=(const MappedVector& other) const
+{
+    return !(*this == other);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+// Bump-pointer arena: allocations are carved sequentially out of geometrically
+// growing blocks and are never freed individually. release() drops everything
+// at once, so per-request scratch containers cost nothing to tear down.
+class MonotonicArena
+{
+   private:
+    struct Block
+    {
+        Block* next;
+        std::size_t size;
+    };
+
+    Block* head_;
+    char* cursor_;
+    char* end_;
+    std::size_t initial_size_;
+    std::size_t next_block_size_;
+    std::size_t bytes_used_;
+
+    void add_block(std::size_t min_bytes);
+
+   public:
+    explicit MonotonicArena(std::size_t initial_size = 4096);
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+    ~MonotonicArena();
+
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+
+    // only the most recent allocation is given back (stack-like), anything else is a no-op
+    void deallocate(void* pointer, std::size_t bytes) noexcept;
+
+    // keeps the first block for reuse and frees the rest; every pointer handed out becomes invalid
+    void release() noexcept;
+
+    std::size_t bytes_used() const noexcept;
+};
+
+template <typename T>
+class ArenaAllocator
+{
+   private:
+    MonotonicArena* arena_;
+
+    template <typename U>
+    friend class ArenaAllocator;
+
+   public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ArenaAllocator(MonotonicArena& arena) noexcept : arena_(&arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena_)
+    {
+    }
+
+    T* allocate(std::size_t count)
+    {
+        if (count > std::numeric_limits<std::size_t>::max() / sizeof(T)) throw std::bad_array_new_length();
+        return static_cast<T*>(arena_->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* pointer, std::size_t count) noexcept { arena_->deallocate(pointer, count * sizeof(T)); }
+
+    MonotonicArena& arena() const noexcept { return *arena_; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& right) const noexcept
+    {
+        return arena_ == right.arena_;
+    }
+};
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+// Slab allocator for container nodes. Requests are rounded up to a multiple of
+// 16 bytes; each size class keeps a free list of returned blocks, and new blocks
+// are carved from 64 KiB slabs, so allocating or freeing a node is a couple of
+// pointer moves instead of a malloc/free. Requests above max_block bytes go
+// straight to operator new.
+//
+// A NodePool object is not thread-safe. The static allocate_shared and
+// deallocate_shared functions serve the whole process instead: each thread keeps
+// its own cache of free blocks and trades them with a central depot in batches,
+// so a node may be freed on a different thread than the one that allocated it.
+class NodePool
+{
+   public:
+    static constexpr std::size_t granularity = 16;
+    static constexpr std::size_t max_block = 256;
+    static constexpr std::size_t slab_size = std::size_t(64) << 10;
+
+   private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct alignas(granularity) Slab
+    {
+        Slab* next;
+    };
+
+    FreeBlock* free_[max_block / granularity];
+    Slab* slabs_;
+    char* cursor_;
+    char* end_;
+    std::size_t slab_count_;
+
+    static std::size_t size_class(std::size_t bytes) noexcept;
+    void add_slab();
+
+   public:
+    NodePool() noexcept;
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+    // frees every slab: the pool must outlive the nodes allocated from it
+    ~NodePool();
+
+    void* allocate(std::size_t bytes);
+    void deallocate(void* pointer, std::size_t bytes) noexcept;
+
+    // drops every slab at once, without visiting the nodes; all pointers handed out become invalid
+    void release() noexcept;
+
+    std::size_t slab_count() const noexcept;
+
+    // process-wide pool behind per-thread caches. Its slabs are never freed; when a thread
+    // exits, its cached blocks go back to the depot for other threads to adopt.
+    static void* allocate_shared(std::size_t bytes);
+    static void deallocate_shared(void* pointer, std::size_t bytes) noexcept;
+};
+
+// Allocator for container nodes. A default-constructed PoolAllocator uses the shared,
+// thread-cached pool; one built from a NodePool uses that pool, e.g. one owned by a batch
+// of scratch lists and released wholesale once they are done.
+template <typename T>
+class PoolAllocator
+{
+   private:
+    static_assert(alignof(T) <= NodePool::granularity, "PoolAllocator cannot satisfy over-aligned types");
+
+    NodePool* pool_;
+
+    template <typename U>
+    friend class PoolAllocator;
+
+   public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    PoolAllocator() noexcept : pool_(nullptr) {}
+    PoolAllocator(NodePool& pool) noexcept : pool_(&pool) {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : pool_(other.pool_)
+    {
+    }
+
+    T* allocate(std::size_t count)
+    {
+        if (count > std::numeric_limits<std::size_t>::max() / sizeof(T)) throw std::bad_array_new_length();
+        std::size_t bytes = count * sizeof(T);
+        return static_cast<T*>(pool_ ? pool_->allocate(bytes) : NodePool::allocate_shared(bytes));
+    }
+
+    void deallocate(T* pointer, std::size_t count) noexcept
+    {
+        if (pool_)
+            pool_->deallocate(pointer, count * sizeof(T));
+        else
+            NodePool::deallocate_shared(pointer, count * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& right) const noexcept
+    {
+        return pool_ == right.pool_;
+    }
+};
@@ -1,48 +1,181 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
 #include <initializer_list>
-#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 
+#include "ThreadPool.h"
+
+// a comparator that accepts keys of other types than the set's (is_transparent, as in std::less<>)
+template <typename Compare>
+concept transparent_compare = requires { typename Compare::is_transparent; };
+
+// Red-black tree of unique keys ordered by Compare. With a transparent comparator (one that
+// declares is_transparent, like std::less<>), lookups also accept any type it can compare
+// against Key, e.g. a std::string_view into a Set<std::string, std::less<>>, without building
+// a temporary Key.
+template <typename Key, typename Compare = std::less<Key>, typename Alloc = std::allocator<Key>>
 class Set
 {
    private:
     struct Node
     {
-        int value;
+        Key value;
         Node* left;
         Node* right;
         Node* parent;
         bool color;
 
-        Node(int val);
+        template <typename... Args>
+        explicit Node(Args&&... args);
     };
+    using node_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using node_traits = std::allocator_traits<node_allocator>;
 
     Node* root_;
-    int size_;
+    // the first and last nodes in order, so begin() and inserts at either end need no descent
+    Node* leftmost_;
+    Node* rightmost_;
+    std::size_t size_;
+    [[no_unique_address]] Compare comp_;
+    [[no_unique_address]] node_allocator alloc_;
+
+    template <typename... Args>
+    Node* createNode(Args&&... args);
+    void destroyNode(Node* node) noexcept;
+
+    template <typename K>
+    Node* findNode(const K& key) const;
+    // first node not ordered before key
+    template <typename K>
+    Node* lowerBoundNode(const K& key) const;
+    // first node ordered after key
+    template <typename K>
+    Node* upperBoundNode(const K& key) const;
+    static Node* successor(Node* node) noexcept;
+    static Node* predecessor(Node* node) noexcept;
+    // find element with one comparison per level, then at most one more against its in-order
+    // neighbour; returns the new node, or the existing one with inserted == false
+    template <typename K>
+    Node* insertValue(K&& element, bool& inserted);
+    template <typename K>
+    Node* insertHint(Node* hint, K&& element);
+    // attach the new node t as a child of parent (nullptr for an empty tree) and rebalance
+    void linkNode(Node* t, Node* parent, bool left);
+    void eraseNode(Node* node);
+    // reset leftmost_ and rightmost_ after the tree was rebuilt
+    void findExtremes() noexcept;
+    // take every node of other, which must use an equal allocator; this set must be empty
+    void stealTree(Set& other) noexcept;
+
+    // build a perfectly balanced subtree from the next count distinct keys of a sorted range,
+    // advancing first past them (and past duplicates unless Distinct); nodes at redDepth, the
+    // partial bottom level, are red
+    template <bool Distinct, typename It>
+    Node* buildSorted(It& first, It last, std::size_t count, std::size_t depth, std::size_t redDepth, Node* parent);
+
+    enum class Combine
+    {
+        Union,
+        Intersection,
+        Difference
+    };
+
+    // subtrees below this many keys are built by a single task
+    static constexpr std::size_t parallel_grain = std::size_t(1) << 14;
+
+    // walks a vector of key pointers as the keys themselves, for buildSorted
+    struct KeyCursor
+    {
+        const Key* const* position;
+
+        const Key& operator*() const { return **position; }
+        KeyCursor& operator++()
+        {
+            ++position;
+            return *this;
+        }
+        bool operator!=(const KeyCursor& right) const { return position != right.position; }
+    };
+
+    // a subtree of the result left for the parallel phase of buildBalanced
+    struct Subtree
+    {
+        std::size_t start;
+        std::size_t count;
+        std::size_t depth;
+        Node* parent;
+        Node** link;
+    };
 
-    bool compareNodes(Node* node1, Node* node2) const;
+    std::vector<const Key*> keyPointers() const;
+    // merge two sorted runs of distinct keys into out according to Op
+    template <Combine Op>
+    void mergeKeys(const Key* const* left, const Key* const* leftEnd, const Key* const* right,
+                   const Key* const* rightEnd, std::vector<const Key*>& out) const;
+    template <Combine Op, typename Policy>
+    Set combine(Policy&& policy, const Set& right) const;
+    // build the levels above parallel_grain keys here, recording the subtrees below them
+    void splitBuild(const std::vector<const Key*>& keys, std::size_t start, std::size_t count, std::size_t depth,
+                    std::size_t redDepth, Node* parent, Node*& link, std::vector<Subtree>& subtrees);
+    // make the empty set a perfectly balanced tree of keys, which are sorted and distinct
+    template <typename Policy>
+    void buildBalanced(Policy&& policy, const std::vector<const Key*>& keys);
+    // fill the empty set from a sorted range in O(n), dropping duplicates
+    template <std::forward_iterator It>
+    void assignSorted(It first, It last);
 
    public:
+    using key_type = Key;
+    using value_type = Key;
+    using key_compare = Compare;
+    using allocator_type = Alloc;
+
     Set();
+    explicit Set(const Compare& comp, const Alloc& alloc = Alloc());
+    explicit Set(const Alloc& alloc);
     Set(const Set& right);
-    Set(std::initializer_list<int> li);
+    Set(Set&& right) noexcept;
+    // sorted input (checked in one pass, forward iterators only) is built in O(n); anything
+    // else is inserted one key at a time
+    template <std::input_iterator It>
+    Set(It first, It last, const Compare& comp = Compare(), const Alloc& alloc = Alloc());
+    Set(std::initializer_list<Key> li, const Compare& comp = Compare(), const Alloc& alloc = Alloc());
     ~Set();
 
+    // build from a range already sorted by comp, in O(n) and without rebalancing; duplicates
+    // are dropped. Sortedness is not checked: a key that is not greater than the one before it
+    // is dropped as a duplicate, so unsorted input never reads past last, but the set's order
+    // and lookups are then unspecified until it is cleared or destroyed.
+    template <std::forward_iterator It>
+    static Set from_sorted(It first, It last, const Compare& comp = Compare(), const Alloc& alloc = Alloc());
+
+    // keys are immutable, so iterator and const_iterator are the same type
     class iterator
     {
        private:
         Node* current;
 
        public:
+        iterator() : current(nullptr) {}
         iterator(Node* current);
 
-        using iterator_category = std::bidirectional_iterator_tag;
-        using value_type = int;
+        // nodes have no parent link back from end(), so iteration runs forward only
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Key;
         using difference_type = std::ptrdiff_t;
-        using pointer = int*;
-        using reference = int&;
+        using pointer = const Key*;
+        using reference = const Key&;
 
-        const int& operator*();
+        const Key& operator*() const;
+        const Key* operator->() const;
 
         iterator& operator++();
         iterator operator++(int);
@@ -54,35 +187,1231 @@ class Set
 
         Node* getCurrent();
     };
+    using const_iterator = iterator;
 
     Set& operator=(const Set& right);
+    Set& operator=(Set&& right) noexcept(node_traits::propagate_on_container_move_assignment::value ||
+                                         node_traits::is_always_equal::value);
 
+    // equal keys in the same order, whatever the shape of either tree
     bool operator==(const Set& right) const;
     bool operator!=(const Set& right) const;
 
+    // set algebra in O(n + m): the keys of both sets are merged and the result is built as a
+    // perfectly balanced tree, with no rebalancing. The exec::par overloads merge key ranges and
+    // build subtrees of the result on the pool; the allocator must then be thread-safe.
+    Set set_union(const Set& right) const;
+    Set intersect(const Set& right) const;
+    Set difference(const Set& right) const;
+    template <exec::execution_policy Policy>
+    Set set_union(Policy&& policy, const Set& right) const;
+    template <exec::execution_policy Policy>
+    Set intersect(Policy&& policy, const Set& right) const;
+    template <exec::execution_policy Policy>
+    Set difference(Policy&& policy, const Set& right) const;
+
+    allocator_type get_allocator() const noexcept;
+    key_compare key_comp() const;
+
     void clear(Node* node);
 
     void rotateLeft(Node* node);
     void rotateRight(Node* node);
 
     void balanceInsertion(Node* node);
-    void balanceErase(Node* node);
+    void balanceErase(Node* node, Node* parent);
 
-    Node* min(Node* node);
+    Node* min(Node* node) const;
     Node* copyTree(const Node* node, Node* parent);
 
     void transplant(Node* u, Node* v);
 
-    void insert(int element);
-    void erase(int element);
-    bool contains(int element) const;
+    std::pair<iterator, bool> insert(const Key& element);
+    std::pair<iterator, bool> insert(Key&& element);
+    // insert as close as possible before hint: amortized O(1) when element belongs right
+    // before hint or right after the node preceding it, e.g. insert(end(), key) for keys
+    // arriving in ascending order; otherwise an ordinary insert
+    iterator insert(iterator hint, const Key& element);
+    iterator insert(iterator hint, Key&& element);
+    void erase(const Key& element);
+    template <typename K>
+        requires transparent_compare<Compare>
+    void erase(const K& element);
+    bool contains(const Key& element) const;
+    template <typename K>
+        requires transparent_compare<Compare>
+    bool contains(const K& element) const;
     bool empty() const noexcept;
-    int size() const noexcept;
+    std::size_t size() const noexcept;
 
-    iterator begin();
-    iterator end();
-    iterator find(int element);
+    iterator begin() const;
+    iterator end() const;
+    iterator find(const Key& element) const;
+    template <typename K>
+        requires transparent_compare<Compare>
+    iterator find(const K& element) const;
     void erase(iterator it);
-    iterator lower_bound(int value);
-    iterator upper_bound(int value);
+    iterator lower_bound(const Key& value) const;
+    template <typename K>
+        requires transparent_compare<Compare>
+    iterator lower_bound(const K& value) const;
+    iterator upper_bound(const Key& value) const;
+    template <typename K>
+        requires transparent_compare<Compare>
+    iterator upper_bound(const K& value) const;
 };
+
+template <typename Key, typename Compare, typename Alloc>
+template <typename... Args>
+Set<Key, Compare, Alloc>::Node::Node(Args&&... args)
+    : value(std::forward<Args>(args)...), left(nullptr), right(nullptr), parent(nullptr), color(true)
+{
+}
+
+template <typename Key, typename Compare, typename Alloc>
+Set<Key, Compare, Alloc>::Set() : Set(Compare())
+{
+}
+
+template <typename Key, typename Compare, typename Alloc>
+Set<Key, Compare, Alloc>::Set(const Compare& comp, const Alloc& alloc)
+    : root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0), comp_(comp), alloc_(alloc)
+{
+}
+
+template <typename Key, typename Compare, typename Alloc>
+Set<Key, Compare, Alloc>::Set(const Alloc& alloc) : Set(Compare(), alloc)
+{
+}
+
+template <typename Key, typename Compare, typename Alloc>
+Set<Key, Compare, Alloc>::~Set()
+{
+    clear(root_);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+template <typename... Args>
+typename Set<Key, Compare, Alloc>::Node* Set<Key, Compare, Alloc>::createNode(Args&&... args)
+{
+    Node* node = node_traits::allocate(alloc_, 1);
+    try
+    {
+        node_traits::construct(alloc_, node, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        node_traits::deallocate(alloc_, node, 1);
+        throw;
+    }
+    return node;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void Set<Key, Compare, Alloc>::destroyNode(Node* node) noexcept
+{
+    node_traits::destroy(alloc_, node);
+    node_traits::deallocate(alloc_, node, 1);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+typename Set<Key, Compare, Alloc>::allocator_type Set<Key, Compare, Alloc>::get_allocator() const noexcept
+{
+    return allocator_type(alloc_);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+typename Set<Key, Compare, Alloc>::key_compare Set<Key, Compare, Alloc>::key_comp() const
+{
+    return comp_;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+bool Set<Key, Compare, Alloc>::empty() const noexcept
+{
+    return !root_;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+std::size_t Set<Key, Compare, Alloc>::size() const noexcept
+{
+    return size_;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+Set<Key, Compare, Alloc>& Set<Key, Compare, Alloc>::operator=(const Set& other)
+{
+    if (this != &other)
+    {
+        clear(root_);
+        root_ = leftmost_ = rightmost_ = nullptr;
+        size_ = 0;
+
+        comp_ = other.comp_;
+        if constexpr (node_traits::propagate_on_container_copy_assignment::value) alloc_ = other.alloc_;
+
+        if (other.root_)
+        {
+            root_ = copyTree(other.root_, nullptr);
+            size_ = other.size_;
+            findExtremes();
+        }
+    }
+    return *this;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+bool Set<Key, Compare, Alloc>::operator==(const Set& other) const
+{
+    if (size_ != other.size_) return false;
+
+    for (iterator left = begin(), right = other.begin(); left != end(); ++left, ++right)
+    {
+        if (comp_(*left, *right) || comp_(*right, *left)) return false;
+    }
+    return true;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+bool Set<Key, Compare, Alloc>::operator!=(const Set& other) const
+{
+    return !(*this == other);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+typename Set<Key, Compare, Alloc>::Node* Set<Key, Compare, Alloc>::copyTree(const Node* node, Node* parent)
+{
+    if (!node) return nullptr;
+
+    Node* newNode = createNode(node->value);
+    newNode->color = node->color;
+    newNode->parent = parent;
+
+    try
+    {
+        newNode->left = copyTree(node->left, newNode);
+        newNode->right = copyTree(node->right, newNode);
+    }
+    catch (...)
+    {
+        clear(newNode);
+        throw;
+    }
+
+    return newNode;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+Set<Key, Compare, Alloc>::Set(const Set& other)
+    : root_(nullptr),
+      leftmost_(nullptr),
+      rightmost_(nullptr),
+      size_(0),
+      comp_(other.comp_),
+      alloc_(node_traits::select_on_container_copy_construction(other.alloc_))
+{
+    if (other.root_)
+    {
+        root_ = copyTree(other.root_, nullptr);
+        size_ = other.size_;
+        findExtremes();
+    }
+}
+
+template <typename Key, typename Compare, typename Alloc>
+Set<Key, Compare, Alloc>::Set(Set&& other) noexcept
+    : root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0), comp_(other.comp_), alloc_(std::move(other.alloc_))
+{
+    stealTree(other);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+Set<Key, Compare, Alloc>& Set<Key, Compare, Alloc>::operator=(Set&& right) noexcept(node_traits::propagate_on_container_move_assignment::value ||
+                                                                        node_traits::is_always_equal::value)
+{
+    if (this == &right) return *this;
+    clear(root_);
+    root_ = leftmost_ = rightmost_ = nullptr;
+    size_ = 0;
+
+    comp_ = right.comp_;
+    if constexpr (node_traits::propagate_on_container_move_assignment::value)
+    {
+        alloc_ = std::move(right.alloc_);
+    }
+    else if (alloc_ != right.alloc_)
+    {
+        // our allocator cannot free right's nodes: copy the keys, already in order, into our own
+        assignSorted(right.begin(), right.end());
+        right.clear(right.root_);
+        right.root_ = right.leftmost_ = right.rightmost_ = nullptr;
+        right.size_ = 0;
+        return *this;
+    }
+    stealTree(right);
+    return *this;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void Set<Key, Compare, Alloc>::stealTree(Set& other) noexcept
+{
+    root_ = std::exchange(other.root_, nullptr);
+    leftmost_ = std::exchange(other.leftmost_, nullptr);
+    rightmost_ = std::exchange(other.rightmost_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void Set<Key, Compare, Alloc>::findExtremes() noexcept
+{
+    leftmost_ = min(root_);
+    rightmost_ = root_;
+    if (rightmost_)
+    {
+        while (rightmost_->right) rightmost_ = rightmost_->right;
+    }
+}
+
+template <typename Key, typename Compare, typename Alloc>
+Set<Key, Compare, Alloc>::Set(std::initializer_list<Key> li, const Compare& comp, const Alloc& alloc) : Set(li.begin(), li.end(), comp, alloc)
+{
+}
+
+template <typename Key, typename Compare, typename Alloc>
+template <std::input_iterator It>
+Set<Key, Compare, Alloc>::Set(It first, It last, const Compare& comp, const Alloc& alloc) : Set(comp, alloc)
+{
+    try
+    {
+        if constexpr (std::forward_iterator<It>)
+        {
+            if (std::is_sorted(first, last, comp_))
+            {
+                assignSorted(first, last);
+                return;
+            }
+        }
+        for (; first != last; ++first) insert(end(), *first);
+    }
+    catch (...)
+    {
+        clear(root_);
+        throw;
+    }
+}
+
+template <typename Key, typename Compare, typename Alloc>
+template <std::forward_iterator It>
+Set<Key, Compare, Alloc> Set<Key, Compare, Alloc>::from_sorted(It first, It last, const Compare& comp, const Alloc& alloc)
+{
+    Set set(comp, alloc);
+    set.assignSorted(first, last);
+    return set;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+template <std::forward_iterator It>
+void Set<Key, Compare, Alloc>::assignSorted(It first, It last)
+{
+    std::size_t count = 0;
+    for (It it = first, previous = first; it != last; previous = it, ++it)
+    {
+        if (it == first || comp_(*previous, *it)) ++count;
+    }
+
+    // a median split fills every level above floor(log2(count + 1)) completely; coloring the
+    // nodes below that red gives every path the same number of black nodes
+    std::size_t redDepth = std::bit_width(count + 1) - 1;
+    root_ = buildSorted<false>(first, last, count, 0, redDepth, nullptr);
+    size_ = count;
+    findExtremes();
+}
+
+template <typename Key, typename Compare, typename Alloc>
+template <bool Distinct, typename It>
+typename Set<Key, Compare, Alloc>::Node* Set<Key, Compare, Alloc>::buildSorted(It& first, It last, std::size_t count, std::size_t depth,
+                                                                std::size_t redDepth, Node* parent)
+{
+    if (count == 0) return nullptr;
+
+    std::size_t leftCount = (count - 1) / 2;
+    Node* left = buildSorted<Distinct>(first, last, leftCount, depth + 1, redDepth, nullptr);
+    Node* node;
+    try
+    {
+        node = createNode(*first);
+    }
+    catch (...)
+    {
+        clear(left);
+        throw;
+    }
+    node->color = depth == redDepth;
+    node->parent = parent;
+    node->left = left;
+    if (left) left->parent = node;
+
+    if constexpr (Distinct)
+    {
+        ++first;
+    }
+    else
+    {
+        // skip exactly the keys assignSorted did not count: those not greater than their predecessor
+        It previous = first;
+        for (++first; first != last && !comp_(*previous, *first); ++first) previous = first;
+    }
+
+    try
+    {
+        node->right = buildSorted<Distinct>(first, last, count - 1 - leftCount, depth + 1, redDepth, node);
+    }
+    catch (...)
+    {
+        clear(node);
+        throw;
+    }
+    return node;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void Set<Key, Compare, Alloc>::clear(Node* node)
+{
+    if (node)
+    {
+        clear(node->left);
+        clear(node->right);
+        destroyNode(node);
+    }
+}
+
+template <typename Key, typename Compare, typename Alloc>
+template <typename K>
+typename Set<Key, Compare, Alloc>::Node* Set<Key, Compare, Alloc>::findNode(const K& element) const
+{
+    Node* search = root_;
+    while (search)
+    {
+        if (comp_(search->value, element))
+            search = search->right;
+        else if (comp_(element, search->value))
+            search = search->left;
+        else
+            return search;
+    }
+    return nullptr;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+bool Set<Key, Compare, Alloc>::contains(const Key& element) const
+{
+    return findNode(element) != nullptr;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+template <typename K>
+    requires transparent_compare<Compare>
+bool Set<Key, Compare, Alloc>::contains(const K& element) const
+{
+    return findNode(element) != nullptr;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+std::pair<typename Set<Key, Compare, Alloc>::iterator, bool> Set<Key, Compare, Alloc>::insert(const Key& element)
+{
+    bool inserted;
+    Node* node = insertValue(element, inserted);
+    return {iterator(node), inserted};
+}
+
+template <typename Key, typename Compare, typename Alloc>
+std::pair<typename Set<Key, Compare, Alloc>::iterator, bool> Set<Key, Compare, Alloc>::insert(Key&& element)
+{
+    bool inserted;
+    Node* node = insertValue(std::move(element), inserted);
+    return {iterator(node), inserted};
+}
+
+template <typename Key, typename Compare, typename Alloc>
+typename Set<Key, Compare, Alloc>::iterator Set<Key, Compare, Alloc>::insert(iterator hint, const Key& element)
+{
+    return iterator(insertHint(hint.getCurrent(), element));
+}
+
+template <typename Key, typename Compare, typename Alloc>
+typename Set<Key, Compare, Alloc>::iterator Set<Key, Compare, Alloc>::insert(iterator hint, Key&& element)
+{
+    return iterator(insertHint(hint.getCurrent(), std::move(element)));
+}
+
+template <typename Key, typename Compare, typename Alloc>
+template <typename K>
+typename Set<Key, Compare, Alloc>::Node* Set<Key, Compare, Alloc>::insertValue(K&& element, bool& inserted)
+{
+    Node* parent = nullptr;
+    Node* current = root_;
+    bool left = true;
+    while (current)
+    {
+        parent = current;
+        left = comp_(element, current->value);
+        current = left ? current->left : current->right;
+    }
+
+    // element is not before parent's predecessor (or parent itself, if it went right),
+    // so it is a duplicate unless it is after that node
+    Node* before = left ? (parent == leftmost_ ? nullptr : predecessor(parent)) : parent;
+    inserted = !before || comp_(before->value, element);
+    if (!inserted) return before;
+
+    Node* t = createNode(std::forward<K>(element));
+    linkNode(t, parent, left);
+    return t;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+template <typename K>
+typename Set<Key, Compare, Alloc>::Node* Set<Key, Compare, Alloc>::insertHint(Node* hint, K&& element)
+{
+    bool inserted;
+    if (!hint)
+    {
+        // appending: element must go after the last node
+        if (rightmost_ && comp_(rightmost_->value, element))
+        {
+            Node* t = createNode(std::forward<K>(element));
+            linkNode(t, rightmost_, false);
+            return t;
+        }
+        return insertValue(std::forward<K>(element), inserted);
+    }
+
+    if (comp_(element, hint->value))
+    {
+        Node* before = hint == leftmost_ ? nullptr : predecessor(hint);
+        if (!before || comp_(before->value, element))
+        {
+            // before and hint are adjacent, so one of the two slots between them is free
+            Node* t = createNode(std::forward<K>(element));
+            if (!hint->left)
+                linkNode(t, hint, true);
+            else
+                linkNode(t, before, false);
+            return t;
+        }
+    }
+    else if (comp_(hint->value, element))
+    {
+        Node* after = hint == rightmost_ ? nullptr : successor(hint);
+        if (!after || comp_(element, after->value))
+        {
+            Node* t = createNode(std::forward<K>(element));
+            if (!hint->right)
+                linkNode(t, hint, false);
+            else
+                linkNode(t, after, true);
+            return t;
+        }
+    }
+    else
+    {
+        return hint;
+    }
+    return insertValue(std::forward<K>(element), inserted);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void Set<Key, Compare, Alloc>::linkNode(Node* t, Node* parent, bool left)
+{
+    t->parent = parent;
+    if (!parent)
+    {
+        root_ = leftmost_ = rightmost_ = t;
+    }
+    else if (left)
+    {
+        parent->left = t;
+        if (parent == leftmost_) leftmost_ = t;
+    }
+    else
+    {
+        parent->right = t;
+        if (parent == rightmost_) rightmost_ = t;
+    }
+    balanceInsertion(t);
+    size_++;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+typename Set<Key, Compare, Alloc>::Node* Set<Key, Compare, Alloc>::successor(Node* node) noexcept
+{
+    if (node->right)
+    {
+        node = node->right;
+        while (node->left) node = node->left;
+        return node;
+    }
+    Node* parentNode = node->parent;
+    while (parentNode && node == parentNode->right)
+    {
+        node = parentNode;
+        parentNode = parentNode->parent;
+    }
+    return parentNode;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+typename Set<Key, Compare, Alloc>::Node* Set<Key, Compare, Alloc>::predecessor(Node* node) noexcept
+{
+    if (node->left)
+    {
+        node = node->left;
+        while (node->right) node = node->right;
+        return node;
+    }
+    Node* parentNode = node->parent;
+    while (parentNode && node == parentNode->left)
+    {
+        node = parentNode;
+        parentNode = parentNode->parent;
+    }
+    return parentNode;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void Set<Key, Compare, Alloc>::balanceInsertion(Node* t)
+{
+    if (t == root_)
+    {
+        t->color = false;
+        return;
+    }
+    while (t->parent && t->parent->color)
+    {
+        if (t->parent == t->parent->parent->left)
+        {
+            if (t->parent->parent == nullptr) break;
+            Node* uncle = t->parent->parent->right;
+            if (uncle && uncle->color)
+            {
+                t->parent->color = false;
+                uncle->color = false;
+                t->parent->parent->color = true;
+                t = t->parent->parent;
+            }
+            else
+            {
+                if (t == t->parent->right)
+                {
+                    t = t->parent;
+                    rotateLeft(t);
+                }
+                t->parent->color = false;
+                t->parent->parent->color = true;
+                rotateRight(t->parent->parent);
+            }
+        }
+        else
+        {
+            Node* uncle = t->parent->parent->left;
+            if (uncle && uncle->color)
+            {
+                t->parent->color = false;
+                uncle->color = false;
+                t->parent->parent->color = true;
+                t = t->parent->parent;
+            }
+            else
+            {
+                if (t == t->parent->left)
+                {
+                    t = t->parent;
+                    rotateRight(t);
+                }
+                t->parent->color = false;
+                t->parent->parent->color = true;
+                rotateLeft(t->parent->parent);
+            }
+        }
+    }
+    root_->color = false;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void Set<Key, Compare, Alloc>::erase(const Key& element)
+{
+    if (Node* node = findNode(element)) eraseNode(node);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+template <typename K>
+    requires transparent_compare<Compare>
+void Set<Key, Compare, Alloc>::erase(const K& element)
+{
+    if (Node* node = findNode(element)) eraseNode(node);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void Set<Key, Compare, Alloc>::eraseNode(Node* node)
+{
+    if (node == leftmost_) leftmost_ = successor(node);
+    if (node == rightmost_) rightmost_ = predecessor(node);
+
+    Node* target = node;
+    Node* replacement = nullptr;
+    // replacement may be null, so its parent is tracked separately for balanceErase
+    Node* replacementParent = node->parent;
+    bool targetOriginalColor = target->color;
+
+    if (!node->left && !node->right)
+    {
+        transplant(node, nullptr);
+    }
+    else if (!node->left)
+    {
+        replacement = node->right;
+        transplant(node, node->right);
+    }
+    else if (!node->right)
+    {
+        replacement = node->left;
+        transplant(node, node->left);
+    }
+    else
+    {
+        target = min(node->right);
+        targetOriginalColor = target->color;
+        replacement = target->right;
+
+        if (target->parent == node)
+        {
+            replacementParent = target;
+            if (replacement) replacement->parent = target;
+        }
+        else
+        {
+            replacementParent = target->parent;
+            transplant(target, target->right);
+            target->right = node->right;
+            if (target->right) target->right->parent = target;
+        }
+
+        transplant(node, target);
+        target->left = node->left;
+        if (target->left) target->left->parent = target;
+        target->color = node->color;
+    }
+    destroyNode(node);
+
+    if (!targetOriginalColor) balanceErase(replacement, replacementParent);
+    size_--;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void Set<Key, Compare, Alloc>::balanceErase(Node* node, Node* parent)
+{
+    while (node != root_ && (!node || node->color == false))
+    {
+        if (node == parent->left)
+        {
+            Node* brother = parent->right;
+
+            if (!brother)
+            {
+                node = parent;
+                parent = node->parent;
+                continue;
+            }
+
+            if (brother && brother->color == true)
+            {
+                brother->color = false;
+                parent->color = true;
+                rotateLeft(parent);
+                brother = parent->right;
+            }
+            if ((!brother->left || brother->left->color == false) &&
+                (!brother->right || brother->right->color == false))
+            {
+                brother->color = true;
+                node = parent;
+                parent = node->parent;
+            }
+            else
+            {
+                if (!brother->right || brother->right->color == false)
+                {
+                    if (brother->left) brother->left->color = false;
+                    brother->color = true;
+                    rotateRight(brother);
+                    brother = parent->right;
+                }
+                brother->color = parent->color;
+                parent->color = false;
+                if (brother->right) brother->right->color = false;
+                rotateLeft(parent);
+                node = root_;
+                parent = nullptr;
+            }
+        }
+        else
+        {
+            Node* brother = parent->left;
+
+            if (!brother)
+            {
+                node = parent;
+                parent = node->parent;
+                continue;
+            }
+
+            if (brother && brother->color == true)
+            {
+                brother->color = false;
+                parent->color = true;
+                rotateRight(parent);
+                brother = parent->left;
+            }
+            if ((!brother->left || brother->left->color == false) &&
+                (!brother->right || brother->right->color == false))
+            {
+                brother->color = true;
+                node = parent;
+                parent = node->parent;
+            }
+            else
+            {
+                if (!brother->left || brother->left->color == false)
+                {
+                    if (brother->right) brother->right->color = false;
+                    brother->color = true;
+                    rotateLeft(brother);
+                    brother = parent->left;
+                }
+                brother->color = parent->color;
+                parent->color = false;
+                if (brother->left) brother->left->color = false;
+                rotateRight(parent);
+                node = root_;
+                parent = nullptr;
+            }
+        }
+    }
+    if (node) node->color = false;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void Set<Key, Compare, Alloc>::rotateLeft(Node* x)
+{
+    if (!x || !x->right) return;
+
+    Node* y = x->right;
+    x->right = y->left;
+    if (y->left) y->left->parent = x;
+    y->parent = x->parent;
+    if (!x->parent)
+        root_ = y;
+    else if (x == x->parent->left)
+        x->parent->left = y;
+    else
+        x->parent->right = y;
+    y->left = x;
+    x->parent = y;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void Set<Key, Compare, Alloc>::rotateRight(Node* x)
+{
+    if (!x || !x->left) return;
+
+    Node* y = x->left;
+    x->left = y->right;
+    if (y->right) y->right->parent = x;
+    y->parent = x->parent;
+    if (!x->parent)
+        root_ = y;
+    else if (x == x->parent->right)
+        x->parent->right = y;
+    else
+        x->parent->left = y;
+    y->right = x;
+    x->parent = y;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+typename Set<Key, Compare, Alloc>::Node* Set<Key, Compare, Alloc>::iterator::min(Node* node)
+{
+    if (!node) return nullptr;
+    while (node->left) node = node->left;
+    return node;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+typename Set<Key, Compare, Alloc>::Node* Set<Key, Compare, Alloc>::min(Node* node) const
+{
+    if (!node) return nullptr;
+    while (node->left) node = node->left;
+    return node;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void Set<Key, Compare, Alloc>::transplant(Node* u, Node* v)
+{
+    if (u->parent == nullptr)
+        root_ = v;
+    else if (u == u->parent->left)
+        u->parent->left = v;
+    else
+        u->parent->right = v;
+    if (v != nullptr) v->parent = u->parent;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+Set<Key, Compare, Alloc>::iterator::iterator(Node* current_) : current(current_)
+{
+}
+
+template <typename Key, typename Compare, typename Alloc>
+const Key& Set<Key, Compare, Alloc>::iterator::operator*() const
+{
+    return current->value;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+const Key* Set<Key, Compare, Alloc>::iterator::operator->() const
+{
+    return &current->value;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+typename Set<Key, Compare, Alloc>::iterator Set<Key, Compare, Alloc>::begin() const
+{
+    return iterator(leftmost_);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+typename Set<Key, Compare, Alloc>::iterator Set<Key, Compare, Alloc>::end() const
+{
+    return iterator(nullptr);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+typename Set<Key, Compare, Alloc>::iterator Set<Key, Compare, Alloc>::find(const Key& element) const
+{
+    return iterator(findNode(element));
+}
+
+template <typename Key, typename Compare, typename Alloc>
+template <typename K>
+    requires transparent_compare<Compare>
+typename Set<Key, Compare, Alloc>::iterator Set<Key, Compare, Alloc>::find(const K& element) const
+{
+    return iterator(findNode(element));
+}
+
+template <typename Key, typename Compare, typename Alloc>
+bool Set<Key, Compare, Alloc>::iterator::operator==(const iterator& right) const
+{
+    return current == right.current;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+bool Set<Key, Compare, Alloc>::iterator::operator!=(const iterator& right) const
+{
+    return current != right.current;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+typename Set<Key, Compare, Alloc>::iterator& Set<Key, Compare, Alloc>::iterator::operator++()
+{
+    if (this->current == nullptr) return *this;
+    if (current->right)
+    {
+        current = min(current->right);
+    }
+    else
+    {
+        Node* parentNode = current->parent;
+        while (parentNode != nullptr && current == parentNode->right)
+        {
+            current = parentNode;
+            parentNode = parentNode->parent;
+        }
+        current = parentNode;
+    }
+
+    return *this;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+typename Set<Key, Compare, Alloc>::iterator Set<Key, Compare, Alloc>::iterator::operator++(int)
+{
+    iterator tmp = *this;
+    ++*this;
+    return tmp;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+typename Set<Key, Compare, Alloc>::Node* Set<Key, Compare, Alloc>::iterator::getCurrent()
+{
+    return current;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void Set<Key, Compare, Alloc>::erase(iterator it)
+{
+    if (it != end()) eraseNode(it.getCurrent());
+}
+
+template <typename Key, typename Compare, typename Alloc>
+template <typename K>
+typename Set<Key, Compare, Alloc>::Node* Set<Key, Compare, Alloc>::lowerBoundNode(const K& value) const
+{
+    Node* current = root_;
+    Node* result = nullptr;
+
+    while (current != nullptr)
+    {
+        if (!comp_(current->value, value))
+        {
+            result = current;
+            current = current->left;
+        }
+        else
+        {
+            current = current->right;
+        }
+    }
+
+    return result;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+template <typename K>
+typename Set<Key, Compare, Alloc>::Node* Set<Key, Compare, Alloc>::upperBoundNode(const K& value) const
+{
+    Node* current = root_;
+    Node* result = nullptr;
+
+    while (current != nullptr)
+    {
+        if (comp_(value, current->value))
+        {
+            result = current;
+            current = current->left;
+        }
+        else
+        {
+            current = current->right;
+        }
+    }
+
+    return result;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+typename Set<Key, Compare, Alloc>::iterator Set<Key, Compare, Alloc>::lower_bound(const Key& value) const
+{
+    return iterator(lowerBoundNode(value));
+}
+
+template <typename Key, typename Compare, typename Alloc>
+template <typename K>
+    requires transparent_compare<Compare>
+typename Set<Key, Compare, Alloc>::iterator Set<Key, Compare, Alloc>::lower_bound(const K& value) const
+{
+    return iterator(lowerBoundNode(value));
+}
+
+template <typename Key, typename Compare, typename Alloc>
+typename Set<Key, Compare, Alloc>::iterator Set<Key, Compare, Alloc>::upper_bound(const Key& value) const
+{
+    return iterator(upperBoundNode(value));
+}
+
+template <typename Key, typename Compare, typename Alloc>
+template <typename K>
+    requires transparent_compare<Compare>
+typename Set<Key, Compare, Alloc>::iterator Set<Key, Compare, Alloc>::upper_bound(const K& value) const
+{
+    return iterator(upperBoundNode(value));
+}
+
+template <typename Key, typename Compare, typename Alloc>
+std::vector<const Key*> Set<Key, Compare, Alloc>::keyPointers() const
+{
+    std::vector<const Key*> keys;
+    keys.reserve(size_);
+    for (iterator it = begin(); it != end(); ++it) keys.push_back(&*it);
+    return keys;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+template <typename Set<Key, Compare, Alloc>::Combine Op>
+void Set<Key, Compare, Alloc>::mergeKeys(const Key* const* left, const Key* const* leftEnd, const Key* const* right,
+                                         const Key* const* rightEnd, std::vector<const Key*>& out) const
+{
+    while (left != leftEnd && right != rightEnd)
+    {
+        if (comp_(**left, **right))
+        {
+            if constexpr (Op != Combine::Intersection) out.push_back(*left);
+            ++left;
+        }
+        else if (comp_(**right, **left))
+        {
+            if constexpr (Op == Combine::Union) out.push_back(*right);
+            ++right;
+        }
+        else
+        {
+            if constexpr (Op != Combine::Difference) out.push_back(*left);
+            ++left;
+            ++right;
+        }
+    }
+    if constexpr (Op != Combine::Intersection) out.insert(out.end(), left, leftEnd);
+    if constexpr (Op == Combine::Union) out.insert(out.end(), right, rightEnd);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+template <typename Set<Key, Compare, Alloc>::Combine Op, typename Policy>
+Set<Key, Compare, Alloc> Set<Key, Compare, Alloc>::combine(Policy&& policy, const Set& right) const
+{
+    std::vector<const Key*> leftKeys = keyPointers();
+    std::vector<const Key*> rightKeys = right.keyPointers();
+    std::vector<const Key*> merged;
+
+    if (leftKeys.empty())
+    {
+        if constexpr (Op == Combine::Union) merged = std::move(rightKeys);
+    }
+    else
+    {
+        // each chunk of the left keys takes the right keys from its first key up to the next
+        // chunk's first key, so the chunks merge independently
+        auto bound = [&](std::size_t index)
+        {
+            if (index == 0) return rightKeys.data();
+            if (index == leftKeys.size()) return rightKeys.data() + rightKeys.size();
+            auto position = std::lower_bound(rightKeys.begin(), rightKeys.end(), leftKeys[index],
+                                             [this](const Key* a, const Key* b) { return comp_(*a, *b); });
+            return rightKeys.data() + (position - rightKeys.begin());
+        };
+
+        std::mutex parts_mutex;
+        std::vector<std::pair<std::size_t, std::vector<const Key*>>> parts;
+        exec::for_each_chunk(policy, leftKeys.size(), parallel_grain,
+                             [&](std::size_t begin, std::size_t end)
+                             {
+                                 std::vector<const Key*> part;
+                                 mergeKeys<Op>(leftKeys.data() + begin, leftKeys.data() + end, bound(begin), bound(end), part);
+                                 std::lock_guard<std::mutex> lock(parts_mutex);
+                                 parts.emplace_back(begin, std::move(part));
+                             });
+
+        std::sort(parts.begin(), parts.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        std::size_t total = 0;
+        for (const auto& part : parts) total += part.second.size();
+        merged.reserve(total);
+        for (const auto& part : parts) merged.insert(merged.end(), part.second.begin(), part.second.end());
+    }
+
+    Set result(comp_, allocator_type(node_traits::select_on_container_copy_construction(alloc_)));
+    result.buildBalanced(policy, merged);
+    return result;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void Set<Key, Compare, Alloc>::splitBuild(const std::vector<const Key*>& keys, std::size_t start, std::size_t count,
+                                          std::size_t depth, std::size_t redDepth, Node* parent, Node*& link,
+                                          std::vector<Subtree>& subtrees)
+{
+    link = nullptr;
+    if (count <= parallel_grain)
+    {
+        if (count) subtrees.push_back(Subtree{start, count, depth, parent, &link});
+        return;
+    }
+
+    // the same median split as buildSorted, so the subtrees fit under these nodes
+    std::size_t leftCount = (count - 1) / 2;
+    Node* node = createNode(*keys[start + leftCount]);
+    node->color = depth == redDepth;
+    node->parent = parent;
+    link = node;
+    splitBuild(keys, start, leftCount, depth + 1, redDepth, node, node->left, subtrees);
+    splitBuild(keys, start + leftCount + 1, count - 1 - leftCount, depth + 1, redDepth, node, node->right, subtrees);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+template <typename Policy>
+void Set<Key, Compare, Alloc>::buildBalanced(Policy&& policy, const std::vector<const Key*>& keys)
+{
+    std::size_t redDepth = std::bit_width(keys.size() + 1) - 1;
+    std::vector<Subtree> subtrees;
+    try
+    {
+        splitBuild(keys, 0, keys.size(), 0, redDepth, nullptr, root_, subtrees);
+        exec::for_each_chunk(policy, subtrees.size(), 1,
+                             [&](std::size_t begin, std::size_t end)
+                             {
+                                 for (std::size_t i = begin; i < end; ++i)
+                                 {
+                                     const Subtree& subtree = subtrees[i];
+                                     KeyCursor first{keys.data() + subtree.start};
+                                     KeyCursor last{keys.data() + subtree.start + subtree.count};
+                                     *subtree.link = buildSorted<true>(first, last, subtree.count, subtree.depth, redDepth,
+                                                                       subtree.parent);
+                                 }
+                             });
+    }
+    catch (...)
+    {
+        // every subtree that was built is linked in; the others cleaned up after themselves
+        clear(root_);
+        root_ = nullptr;
+        throw;
+    }
+    size_ = keys.size();
+    findExtremes();
+}
+
+template <typename Key, typename Compare, typename Alloc>
+Set<Key, Compare, Alloc> Set<Key, Compare, Alloc>::set_union(const Set& right) const
+{
+    return combine<Combine::Union>(exec::seq, right);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+Set<Key, Compare, Alloc> Set<Key, Compare, Alloc>::intersect(const Set& right) const
+{
+    return combine<Combine::Intersection>(exec::seq, right);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+Set<Key, Compare, Alloc> Set<Key, Compare, Alloc>::difference(const Set& right) const
+{
+    return combine<Combine::Difference>(exec::seq, right);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+template <exec::execution_policy Policy>
+Set<Key, Compare, Alloc> Set<Key, Compare, Alloc>::set_union(Policy&& policy, const Set& right) const
+{
+    return combine<Combine::Union>(policy, right);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+template <exec::execution_policy Policy>
+Set<Key, Compare, Alloc> Set<Key, Compare, Alloc>::intersect(Policy&& policy, const Set& right) const
+{
+    return combine<Combine::Intersection>(policy, right);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+template <exec::execution_policy Policy>
+Set<Key, Compare, Alloc> Set<Key, Compare, Alloc>::difference(Policy&& policy, const Set& right) const
+{
+    return combine<Combine::Difference>(policy, right);
+}
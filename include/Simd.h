@@ -0,0 +1,361 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+// Vectorized scans over arrays of integral or floating-point elements. Each
+// entry point picks the widest kernel the running CPU supports: AVX2 when
+// cpuid reports it, otherwise SSE2 (always present on x86-64), otherwise the
+// scalar loop. Results are identical to the scalar versions, except that
+// min/max leave the outcome unspecified when NaNs are involved.
+namespace simd
+{
+template <typename T>
+inline constexpr bool vectorizable_v =
+    (std::is_integral_v<T> || std::is_same_v<T, float> || std::is_same_v<T, double>) &&
+    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+namespace scalar
+{
+template <typename T>
+bool equal(const T* left, const T* right, std::size_t size)
+{
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (left[i] != right[i]) return false;
+    }
+    return true;
+}
+
+template <typename T>
+void fill(T* first, std::size_t size, const T& value)
+{
+    for (std::size_t i = 0; i < size; ++i) first[i] = value;
+}
+
+template <typename T>
+std::size_t find(const T* first, std::size_t size, const T& value)
+{
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (first[i] == value) return i;
+    }
+    return size;
+}
+
+template <typename T>
+std::size_t count(const T* first, std::size_t size, const T& value)
+{
+    std::size_t result = 0;
+    for (std::size_t i = 0; i < size; ++i) result += first[i] == value;
+    return result;
+}
+
+template <typename T>
+T min(const T* first, std::size_t size)
+{
+    T result = first[0];
+    for (std::size_t i = 1; i < size; ++i)
+    {
+        if (first[i] < result) result = first[i];
+    }
+    return result;
+}
+
+template <typename T>
+T max(const T* first, std::size_t size)
+{
+    T result = first[0];
+    for (std::size_t i = 1; i < size; ++i)
+    {
+        if (result < first[i]) result = first[i];
+    }
+    return result;
+}
+}  // namespace scalar
+
+#if SIMD_X86
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace avx2
+{
+struct Ops
+{
+    using reg = __m256i;
+    static constexpr std::size_t bytes = 32;
+    static constexpr unsigned full_mask = 0xFFFFFFFFu;
+
+    template <std::size_t Size>
+    static constexpr bool has_integer_gt = true;
+    template <typename T>
+    static constexpr bool has_min = std::is_floating_point_v<T> || sizeof(T) <= 4;
+
+    static reg load(const void* pointer) { return _mm256_loadu_si256(static_cast<const __m256i*>(pointer)); }
+    static void store(void* pointer, reg value) { _mm256_storeu_si256(static_cast<__m256i*>(pointer), value); }
+    static unsigned mask(reg value) { return static_cast<unsigned>(_mm256_movemask_epi8(value)); }
+
+    static reg bit_and(reg a, reg b) { return _mm256_and_si256(a, b); }
+    static reg bit_or(reg a, reg b) { return _mm256_or_si256(a, b); }
+    static reg bit_xor(reg a, reg b) { return _mm256_xor_si256(a, b); }
+    // ~a & b
+    static reg and_not(reg a, reg b) { return _mm256_andnot_si256(a, b); }
+
+    template <typename T>
+    static reg eq(reg a, reg b)
+    {
+        if constexpr (std::is_same_v<T, float>)
+            return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+        else if constexpr (std::is_same_v<T, double>)
+            return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+        else if constexpr (sizeof(T) == 1)
+            return _mm256_cmpeq_epi8(a, b);
+        else if constexpr (sizeof(T) == 2)
+            return _mm256_cmpeq_epi16(a, b);
+        else if constexpr (sizeof(T) == 4)
+            return _mm256_cmpeq_epi32(a, b);
+        else
+            return _mm256_cmpeq_epi64(a, b);
+    }
+
+    // signed integral or floating T
+    template <typename T>
+    static reg gt(reg a, reg b)
+    {
+        if constexpr (std::is_same_v<T, float>)
+            return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_GT_OQ));
+        else if constexpr (std::is_same_v<T, double>)
+            return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_GT_OQ));
+        else if constexpr (sizeof(T) == 1)
+            return _mm256_cmpgt_epi8(a, b);
+        else if constexpr (sizeof(T) == 2)
+            return _mm256_cmpgt_epi16(a, b);
+        else if constexpr (sizeof(T) == 4)
+            return _mm256_cmpgt_epi32(a, b);
+        else
+            return _mm256_cmpgt_epi64(a, b);
+    }
+
+    // T with has_min<T>
+    template <typename T>
+    static reg min(reg a, reg b)
+    {
+        if constexpr (std::is_same_v<T, float>)
+            return _mm256_castps_si256(_mm256_min_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+        else if constexpr (std::is_same_v<T, double>)
+            return _mm256_castpd_si256(_mm256_min_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+        else if constexpr (sizeof(T) == 1)
+            return std::is_signed_v<T> ? _mm256_min_epi8(a, b) : _mm256_min_epu8(a, b);
+        else if constexpr (sizeof(T) == 2)
+            return std::is_signed_v<T> ? _mm256_min_epi16(a, b) : _mm256_min_epu16(a, b);
+        else
+            return std::is_signed_v<T> ? _mm256_min_epi32(a, b) : _mm256_min_epu32(a, b);
+    }
+
+    template <typename T>
+    static reg max(reg a, reg b)
+    {
+        if constexpr (std::is_same_v<T, float>)
+            return _mm256_castps_si256(_mm256_max_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+        else if constexpr (std::is_same_v<T, double>)
+            return _mm256_castpd_si256(_mm256_max_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+        else if constexpr (sizeof(T) == 1)
+            return std::is_signed_v<T> ? _mm256_max_epi8(a, b) : _mm256_max_epu8(a, b);
+        else if constexpr (sizeof(T) == 2)
+            return std::is_signed_v<T> ? _mm256_max_epi16(a, b) : _mm256_max_epu16(a, b);
+        else
+            return std::is_signed_v<T> ? _mm256_max_epi32(a, b) : _mm256_max_epu32(a, b);
+    }
+};
+
+#include "SimdKernels.h"
+}  // namespace avx2
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#if defined(__SSE2__)
+#define SIMD_SSE2 1
+
+namespace sse2
+{
+struct Ops
+{
+    using reg = __m128i;
+    static constexpr std::size_t bytes = 16;
+    static constexpr unsigned full_mask = 0xFFFFu;
+
+    // 64-bit compares need SSE4.2
+    template <std::size_t Size>
+    static constexpr bool has_integer_gt = Size != 8;
+    // SSE2 only has unsigned 8-bit and signed 16-bit integer min/max
+    template <typename T>
+    static constexpr bool has_min = std::is_floating_point_v<T> ||
+                                    (std::is_integral_v<T> && sizeof(T) == 1 && std::is_unsigned_v<T>) ||
+                                    (std::is_integral_v<T> && sizeof(T) == 2 && std::is_signed_v<T>);
+
+    static reg load(const void* pointer) { return _mm_loadu_si128(static_cast<const __m128i*>(pointer)); }
+    static void store(void* pointer, reg value) { _mm_storeu_si128(static_cast<__m128i*>(pointer), value); }
+    static unsigned mask(reg value) { return static_cast<unsigned>(_mm_movemask_epi8(value)); }
+
+    static reg bit_and(reg a, reg b) { return _mm_and_si128(a, b); }
+    static reg bit_or(reg a, reg b) { return _mm_or_si128(a, b); }
+    static reg bit_xor(reg a, reg b) { return _mm_xor_si128(a, b); }
+    // ~a & b
+    static reg and_not(reg a, reg b) { return _mm_andnot_si128(a, b); }
+
+    template <typename T>
+    static reg eq(reg a, reg b)
+    {
+        if constexpr (std::is_same_v<T, float>)
+            return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+        else if constexpr (std::is_same_v<T, double>)
+            return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+        else if constexpr (sizeof(T) == 1)
+            return _mm_cmpeq_epi8(a, b);
+        else if constexpr (sizeof(T) == 2)
+            return _mm_cmpeq_epi16(a, b);
+        else if constexpr (sizeof(T) == 4)
+            return _mm_cmpeq_epi32(a, b);
+        else
+        {
+            // both 32-bit halves must match
+            reg halves = _mm_cmpeq_epi32(a, b);
+            return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+        }
+    }
+
+    template <typename T>
+    static reg gt(reg a, reg b)
+    {
+        if constexpr (std::is_same_v<T, float>)
+            return _mm_castps_si128(_mm_cmpgt_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+        else if constexpr (std::is_same_v<T, double>)
+            return _mm_castpd_si128(_mm_cmpgt_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+        else if constexpr (sizeof(T) == 1)
+            return _mm_cmpgt_epi8(a, b);
+        else if constexpr (sizeof(T) == 2)
+            return _mm_cmpgt_epi16(a, b);
+        else
+            return _mm_cmpgt_epi32(a, b);
+    }
+
+    template <typename T>
+    static reg min(reg a, reg b)
+    {
+        if constexpr (std::is_same_v<T, float>)
+            return _mm_castps_si128(_mm_min_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+        else if constexpr (std::is_same_v<T, double>)
+            return _mm_castpd_si128(_mm_min_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+        else if constexpr (sizeof(T) == 1)
+            return _mm_min_epu8(a, b);
+        else
+            return _mm_min_epi16(a, b);
+    }
+
+    template <typename T>
+    static reg max(reg a, reg b)
+    {
+        if constexpr (std::is_same_v<T, float>)
+            return _mm_castps_si128(_mm_max_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+        else if constexpr (std::is_same_v<T, double>)
+            return _mm_castpd_si128(_mm_max_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+        else if constexpr (sizeof(T) == 1)
+            return _mm_max_epu8(a, b);
+        else
+            return _mm_max_epi16(a, b);
+    }
+};
+
+#include "SimdKernels.h"
+}  // namespace sse2
+
+#endif  // __SSE2__
+
+inline bool cpu_has_avx2()
+{
+    static const bool supported = []
+    {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+    return supported;
+}
+
+#endif  // SIMD_X86
+
+// picks the kernel for T on this CPU; every name below dispatches through it
+#if SIMD_X86 && SIMD_SSE2
+#define SIMD_DISPATCH(function, ...)                                              \
+    if constexpr (vectorizable_v<T>)                                              \
+    {                                                                             \
+        if (cpu_has_avx2()) return avx2::function(__VA_ARGS__);                   \
+        return sse2::function(__VA_ARGS__);                                       \
+    }                                                                             \
+    return scalar::function(__VA_ARGS__)
+#elif SIMD_X86
+#define SIMD_DISPATCH(function, ...)                                              \
+    if constexpr (vectorizable_v<T>)                                              \
+    {                                                                             \
+        if (cpu_has_avx2()) return avx2::function(__VA_ARGS__);                   \
+    }                                                                             \
+    return scalar::function(__VA_ARGS__)
+#else
+#define SIMD_DISPATCH(function, ...) return scalar::function(__VA_ARGS__)
+#endif
+
+template <typename T>
+bool equal(const T* left, const T* right, std::size_t size)
+{
+    SIMD_DISPATCH(equal, left, right, size);
+}
+
+template <typename T>
+void fill(T* first, std::size_t size, const T& value)
+{
+    SIMD_DISPATCH(fill, first, size, value);
+}
+
+// index of the first element equal to value, or size
+template <typename T>
+std::size_t find(const T* first, std::size_t size, const T& value)
+{
+    SIMD_DISPATCH(find, first, size, value);
+}
+
+template <typename T>
+std::size_t count(const T* first, std::size_t size, const T& value)
+{
+    SIMD_DISPATCH(count, first, size, value);
+}
+
+// size must be positive
+template <typename T>
+T min(const T* first, std::size_t size)
+{
+    SIMD_DISPATCH(min, first, size);
+}
+
+template <typename T>
+T max(const T* first, std::size_t size)
+{
+    SIMD_DISPATCH(max, first, size);
+}
+
+#undef SIMD_DISPATCH
+}  // namespace simd
@@ -0,0 +1,219 @@
+// Kernels shared by every instruction set. Simd.h includes this file once per
+// target, inside a namespace that defines Ops (register type, loads, lane
+// compares) and with that target enabled, so there is deliberately no include
+// guard here.
+//
+// All loads and stores are unaligned; tails shorter than one register fall
+// back to scalar code.
+
+template <typename T>
+typename Ops::reg splat(T value)
+{
+    T lanes[Ops::bytes / sizeof(T)];
+    for (auto& lane : lanes) lane = value;
+    return Ops::load(lanes);
+}
+
+// lanes of a that compare greater than b, for any integral or floating T
+template <typename T>
+typename Ops::reg greater(typename Ops::reg a, typename Ops::reg b)
+{
+    if constexpr (std::is_floating_point_v<T> || std::is_signed_v<T>)
+    {
+        return Ops::template gt<T>(a, b);
+    }
+    else
+    {
+        // unsigned order is signed order with the sign bit flipped
+        using S = std::make_signed_t<T>;
+        typename Ops::reg bias = splat<S>(std::numeric_limits<S>::min());
+        return Ops::template gt<S>(Ops::bit_xor(a, bias), Ops::bit_xor(b, bias));
+    }
+}
+
+// integer min/max without a native instruction select through a compare
+template <typename T>
+typename Ops::reg lesser(typename Ops::reg a, typename Ops::reg b)
+{
+    if constexpr (Ops::template has_min<T>)
+    {
+        return Ops::template min<T>(a, b);
+    }
+    else
+    {
+        typename Ops::reg a_greater = greater<T>(a, b);
+        return Ops::bit_or(Ops::bit_and(a_greater, b), Ops::and_not(a_greater, a));
+    }
+}
+
+template <typename T>
+typename Ops::reg larger(typename Ops::reg a, typename Ops::reg b)
+{
+    if constexpr (Ops::template has_min<T>)
+    {
+        return Ops::template max<T>(a, b);
+    }
+    else
+    {
+        typename Ops::reg a_greater = greater<T>(a, b);
+        return Ops::bit_or(Ops::bit_and(a_greater, a), Ops::and_not(a_greater, b));
+    }
+}
+
+template <typename T>
+inline constexpr bool orderable = !std::is_same_v<T, bool> &&
+                                  (Ops::template has_min<T> || Ops::template has_integer_gt<sizeof(T)>);
+
+template <typename T>
+bool equal(const T* left, const T* right, std::size_t size)
+{
+    constexpr std::size_t step = Ops::bytes / sizeof(T);
+    std::size_t i = 0;
+    for (; i + 2 * step <= size; i += 2 * step)
+    {
+        typename Ops::reg same = Ops::bit_and(Ops::template eq<T>(Ops::load(left + i), Ops::load(right + i)),
+                                              Ops::template eq<T>(Ops::load(left + i + step),
+                                                                  Ops::load(right + i + step)));
+        if (Ops::mask(same) != Ops::full_mask) return false;
+    }
+    for (; i + step <= size; i += step)
+    {
+        typename Ops::reg same = Ops::template eq<T>(Ops::load(left + i), Ops::load(right + i));
+        if (Ops::mask(same) != Ops::full_mask) return false;
+    }
+    for (; i < size; ++i)
+    {
+        if (left[i] != right[i]) return false;
+    }
+    return true;
+}
+
+template <typename T>
+void fill(T* first, std::size_t size, T value)
+{
+    constexpr std::size_t step = Ops::bytes / sizeof(T);
+    typename Ops::reg pattern = splat(value);
+    std::size_t i = 0;
+    for (; i + step <= size; i += step)
+    {
+        Ops::store(first + i, pattern);
+    }
+    for (; i < size; ++i)
+    {
+        first[i] = value;
+    }
+}
+
+template <typename T>
+std::size_t find(const T* first, std::size_t size, T value)
+{
+    constexpr std::size_t step = Ops::bytes / sizeof(T);
+    typename Ops::reg needle = splat(value);
+    std::size_t i = 0;
+    for (; i + step <= size; i += step)
+    {
+        unsigned hits = Ops::mask(Ops::template eq<T>(Ops::load(first + i), needle));
+        if (hits) return i + static_cast<std::size_t>(std::countr_zero(hits)) / sizeof(T);
+    }
+    for (; i < size; ++i)
+    {
+        if (first[i] == value) return i;
+    }
+    return size;
+}
+
+template <typename T>
+std::size_t count(const T* first, std::size_t size, T value)
+{
+    constexpr std::size_t step = Ops::bytes / sizeof(T);
+    typename Ops::reg needle = splat(value);
+    std::size_t result = 0;
+    std::size_t i = 0;
+    for (; i + step <= size; i += step)
+    {
+        unsigned hits = Ops::mask(Ops::template eq<T>(Ops::load(first + i), needle));
+        result += static_cast<std::size_t>(std::popcount(hits)) / sizeof(T);
+    }
+    for (; i < size; ++i)
+    {
+        result += first[i] == value;
+    }
+    return result;
+}
+
+// size must be positive; which NaN-involving value wins is unspecified
+template <typename T>
+T min(const T* first, std::size_t size)
+{
+    constexpr std::size_t step = Ops::bytes / sizeof(T);
+    if constexpr (!orderable<T>)
+    {
+        return ::simd::scalar::min(first, size);
+    }
+    else
+    {
+        if (size < 2 * step) return ::simd::scalar::min(first, size);
+
+        // two accumulators hide the compare latency
+        typename Ops::reg even = Ops::load(first);
+        typename Ops::reg odd = Ops::load(first + step);
+        std::size_t i = 2 * step;
+        for (; i + 2 * step <= size; i += 2 * step)
+        {
+            even = lesser<T>(even, Ops::load(first + i));
+            odd = lesser<T>(odd, Ops::load(first + i + step));
+        }
+        if (i + step <= size)
+        {
+            even = lesser<T>(even, Ops::load(first + i));
+            i += step;
+        }
+
+        T lanes[step];
+        Ops::store(lanes, lesser<T>(even, odd));
+        T result = ::simd::scalar::min(lanes, step);
+        for (; i < size; ++i)
+        {
+            if (first[i] < result) result = first[i];
+        }
+        return result;
+    }
+}
+
+template <typename T>
+T max(const T* first, std::size_t size)
+{
+    constexpr std::size_t step = Ops::bytes / sizeof(T);
+    if constexpr (!orderable<T>)
+    {
+        return ::simd::scalar::max(first, size);
+    }
+    else
+    {
+        if (size < 2 * step) return ::simd::scalar::max(first, size);
+
+        // two accumulators hide the compare latency
+        typename Ops::reg even = Ops::load(first);
+        typename Ops::reg odd = Ops::load(first + step);
+        std::size_t i = 2 * step;
+        for (; i + 2 * step <= size; i += 2 * step)
+        {
+            even = larger<T>(even, Ops::load(first + i));
+            odd = larger<T>(odd, Ops::load(first + i + step));
+        }
+        if (i + step <= size)
+        {
+            even = larger<T>(even, Ops::load(first + i));
+            i += step;
+        }
+
+        T lanes[step];
+        Ops::store(lanes, larger<T>(even, odd));
+        T result = ::simd::scalar::max(lanes, step);
+        for (; i < size; ++i)
+        {
+            if (result < first[i]) result = first[i];
+        }
+        return result;
+    }
+}
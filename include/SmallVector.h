@@ -0,0 +1,898 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+
+#include "Vector.h"
+
+// Vector with room for N elements inside the object itself. Nothing is
+// allocated until the (N + 1)-th element; after that the elements live on the
+// heap exactly as in Vector, and shrink_to_fit() moves them back inline once
+// they fit again. The interface mirrors Vector, including its Growth policy for
+// heap buffers and its vectorized scans, but not the execution-policy overloads:
+// those spread large buffers over a thread pool, which an inline buffer never is.
+template <typename T, size_t N, typename Alloc = std::allocator<T>, typename Growth = PowerOfTwoGrowth>
+class SmallVector
+{
+    static_assert(N > 0, "SmallVector needs inline room for at least one element");
+
+   public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector();
+    explicit SmallVector(const Alloc& alloc);
+    explicit SmallVector(size_t size, const Alloc& alloc = Alloc());
+    SmallVector(const SmallVector& other);
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+    SmallVector(size_t size, const T& value, const Alloc& alloc = Alloc());
+    SmallVector(std::initializer_list<T> init, const Alloc& alloc = Alloc());
+    ~SmallVector() noexcept;
+
+    void clear();
+    bool empty() const noexcept;
+    size_t size() const noexcept;
+    size_t capacity() const noexcept;
+    allocator_type get_allocator() const noexcept;
+
+    // true while the elements are stored in the inline buffer
+    bool is_inline() const noexcept;
+
+    T& at(size_t index);
+    const T& at(size_t index) const;
+
+    T& front();
+    const T& front() const;
+
+    T& back();
+    const T& back() const;
+
+    T* data();
+    const T* data() const noexcept;
+
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    SmallVector& push_back(const T& value);
+    void pop_back();
+
+    void reserve(size_t capacity);
+    void shrink_to_fit();
+
+    void swap(SmallVector& other) noexcept(std::is_nothrow_move_assignable_v<SmallVector>);
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args);
+
+    void resize(size_t count);
+    void resize(size_t count, const T& value);
+    // grow without writing the new elements; their values are indeterminate until assigned
+    void resize_uninitialized(size_t count)
+        requires trivially_default_initializable<T>;
+
+    void assign(size_t count, const T& value);
+    template <std::input_iterator InputIt>
+    void assign(InputIt first, InputIt last);
+    void assign(std::initializer_list<T> init);
+
+    // forward ranges are measured first, so the buffer grows at most once
+    iterator insert(const_iterator pos, const T& value);
+    iterator insert(const_iterator pos, size_t count, const T& value);
+    template <std::input_iterator InputIt>
+    iterator insert(const_iterator pos, InputIt first, InputIt last);
+    iterator insert(const_iterator pos, std::initializer_list<T> init);
+
+    template <std::input_iterator InputIt>
+    void append(InputIt first, InputIt last);
+    template <std::ranges::input_range Range>
+    void append(Range&& range);
+
+    // scans through the kernels in Simd.h, as in Vector
+    void fill(const T& value);
+    iterator find(const T& value);
+    const_iterator find(const T& value) const;
+    size_t count(const T& value) const;
+    T min() const;
+    T max() const;
+
+   public:
+    T& operator[](size_t index);
+    const T& operator[](size_t index) const;
+    bool operator==(const SmallVector& other) const;
+    bool operator!=(const SmallVector& other) const;
+    SmallVector& operator=(const SmallVector& other);
+    // inline elements are moved one by one, so this can only be noexcept when moving T is too
+    SmallVector& operator=(SmallVector&& other) noexcept(
+        (std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value ||
+         std::allocator_traits<Alloc>::is_always_equal::value) &&
+        std::is_nothrow_move_constructible_v<T>);
+
+   private:
+    using alloc_traits = std::allocator_traits<Alloc>;
+
+    T* inline_data() noexcept;
+
+    // move (or copy, if moving may throw) count elements into uninitialized memory, all or nothing
+    void move_construct(T* from, size_t count, T* to);
+    // move_construct, then destroy the originals
+    void relocate(T* from, size_t count, T* to);
+    template <typename It>
+    void copy_construct(T* to, It first, size_t count);
+    void fill_construct(T* to, size_t count, const T& value);
+    void destroy_n(T* first, size_t count) noexcept;
+    // open a gap of count elements at index and let construct(T* gap) fill it
+    template <typename Construct>
+    iterator insert_n(size_t index, size_t count, Construct construct);
+    // moves the elements to a buffer of new_capacity, back into the inline buffer if it fits
+    void reallocate(size_t new_capacity);
+    void release_heap() noexcept;
+
+   private:
+    [[no_unique_address]] Alloc alloc_;
+    size_t capacity_;
+    size_t size_;
+    T* array_;
+    alignas(T) unsigned char buffer_[N * sizeof(T)];
+};
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+SmallVector<T, N, Alloc, Growth>::SmallVector() : SmallVector(Alloc())
+{
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+SmallVector<T, N, Alloc, Growth>::SmallVector(const Alloc& alloc)
+    : alloc_(alloc), capacity_(N), size_(0), array_(inline_data())
+{
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+SmallVector<T, N, Alloc, Growth>::SmallVector(size_t size, const Alloc& alloc) : SmallVector(alloc)
+{
+    reserve(size);
+    for (; size_ < size; size_++)
+    {
+        alloc_traits::construct(alloc_, array_ + size_);
+    }
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+SmallVector<T, N, Alloc, Growth>::SmallVector(size_t size, const T& value, const Alloc& alloc) : SmallVector(alloc)
+{
+    reserve(size);
+    for (; size_ < size; size_++)
+    {
+        alloc_traits::construct(alloc_, array_ + size_, value);
+    }
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+SmallVector<T, N, Alloc, Growth>::SmallVector(std::initializer_list<T> init, const Alloc& alloc) : SmallVector(alloc)
+{
+    reserve(init.size());
+    for (const T& value : init)
+    {
+        alloc_traits::construct(alloc_, array_ + size_, value);
+        size_++;
+    }
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+SmallVector<T, N, Alloc, Growth>::SmallVector(const SmallVector& other)
+    : SmallVector(alloc_traits::select_on_container_copy_construction(other.alloc_))
+{
+    reserve(other.size_);
+    for (; size_ < other.size_; size_++)
+    {
+        alloc_traits::construct(alloc_, array_ + size_, other.array_[size_]);
+    }
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+SmallVector<T, N, Alloc, Growth>::SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    : SmallVector(std::move(other.alloc_))
+{
+    if (!other.is_inline())
+    {
+        array_ = other.array_;
+        capacity_ = other.capacity_;
+        size_ = other.size_;
+        other.array_ = other.inline_data();
+        other.capacity_ = N;
+        other.size_ = 0;
+        return;
+    }
+
+    relocate(other.array_, other.size_, array_);
+    size_ = other.size_;
+    other.size_ = 0;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+SmallVector<T, N, Alloc, Growth>::~SmallVector() noexcept
+{
+    clear();
+    release_heap();
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+T* SmallVector<T, N, Alloc, Growth>::inline_data() noexcept
+{
+    return reinterpret_cast<T*>(buffer_);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void SmallVector<T, N, Alloc, Growth>::move_construct(T* from, size_t count, T* to)
+{
+    if constexpr (is_trivially_relocatable_v<T>)
+    {
+        if (count) std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+        return;
+    }
+
+    size_t i = 0;
+    try
+    {
+        for (; i < count; i++)
+        {
+            alloc_traits::construct(alloc_, to + i, std::move_if_noexcept(from[i]));
+        }
+    }
+    catch (...)
+    {
+        destroy_n(to, i);
+        throw;
+    }
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void SmallVector<T, N, Alloc, Growth>::relocate(T* from, size_t count, T* to)
+{
+    move_construct(from, count, to);
+    if constexpr (!is_trivially_relocatable_v<T>) destroy_n(from, count);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+template <typename It>
+void SmallVector<T, N, Alloc, Growth>::copy_construct(T* to, It first, size_t count)
+{
+    if constexpr (std::contiguous_iterator<It> && std::is_same_v<std::iter_value_t<It>, T> &&
+                  std::is_trivially_copyable_v<T>)
+    {
+        if (count) std::memcpy(static_cast<void*>(to), static_cast<const void*>(std::to_address(first)), count * sizeof(T));
+        return;
+    }
+
+    size_t i = 0;
+    try
+    {
+        for (; i < count; ++i, ++first)
+        {
+            alloc_traits::construct(alloc_, to + i, *first);
+        }
+    }
+    catch (...)
+    {
+        destroy_n(to, i);
+        throw;
+    }
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void SmallVector<T, N, Alloc, Growth>::fill_construct(T* to, size_t count, const T& value)
+{
+    if constexpr (simd::vectorizable_v<T>)
+    {
+        simd::fill(to, count, value);
+        return;
+    }
+    size_t i = 0;
+    try
+    {
+        for (; i < count; ++i)
+        {
+            alloc_traits::construct(alloc_, to + i, value);
+        }
+    }
+    catch (...)
+    {
+        destroy_n(to, i);
+        throw;
+    }
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void SmallVector<T, N, Alloc, Growth>::destroy_n(T* first, size_t count) noexcept
+{
+    if constexpr (std::is_trivially_destructible_v<T>) return;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        alloc_traits::destroy(alloc_, first + i);
+    }
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+template <typename Construct>
+typename SmallVector<T, N, Alloc, Growth>::iterator SmallVector<T, N, Alloc, Growth>::insert_n(size_t index, size_t count, Construct construct)
+{
+    if (count == 0) return array_ + index;
+
+    if (size_ + count > capacity_)
+    {
+        // the new buffer is always on the heap: capacity_ is at least N already
+        size_t new_capacity = Growth::next_capacity(capacity_, size_ + count, sizeof(T));
+        T* new_array = alloc_traits::allocate(alloc_, new_capacity);
+        try
+        {
+            construct(new_array + index);
+        }
+        catch (...)
+        {
+            alloc_traits::deallocate(alloc_, new_array, new_capacity);
+            throw;
+        }
+        try
+        {
+            move_construct(array_, index, new_array);
+        }
+        catch (...)
+        {
+            destroy_n(new_array + index, count);
+            alloc_traits::deallocate(alloc_, new_array, new_capacity);
+            throw;
+        }
+        try
+        {
+            move_construct(array_ + index, size_ - index, new_array + index + count);
+        }
+        catch (...)
+        {
+            destroy_n(new_array, index + count);
+            alloc_traits::deallocate(alloc_, new_array, new_capacity);
+            throw;
+        }
+        if constexpr (!is_trivially_relocatable_v<T>) destroy_n(array_, size_);
+        release_heap();
+        array_ = new_array;
+        capacity_ = new_capacity;
+    }
+    else if constexpr (is_trivially_relocatable_v<T>)
+    {
+        T* gap = array_ + index;
+        std::memmove(static_cast<void*>(gap + count), static_cast<const void*>(gap), (size_ - index) * sizeof(T));
+        try
+        {
+            construct(gap);
+        }
+        catch (...)
+        {
+            std::memmove(static_cast<void*>(gap), static_cast<const void*>(gap + count), (size_ - index) * sizeof(T));
+            throw;
+        }
+    }
+    else
+    {
+        // construct at the end, then rotate the block into place
+        construct(array_ + size_);
+        std::rotate(array_ + index, array_ + size_, array_ + size_ + count);
+    }
+    size_ += count;
+    return array_ + index;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void SmallVector<T, N, Alloc, Growth>::reallocate(size_t new_capacity)
+{
+    if (new_capacity <= N)
+    {
+        if (is_inline()) return;
+        relocate(array_, size_, inline_data());
+        release_heap();
+        array_ = inline_data();
+        capacity_ = N;
+        return;
+    }
+
+    T* new_array = alloc_traits::allocate(alloc_, new_capacity);
+    try
+    {
+        relocate(array_, size_, new_array);
+    }
+    catch (...)
+    {
+        alloc_traits::deallocate(alloc_, new_array, new_capacity);
+        throw;
+    }
+    release_heap();
+    array_ = new_array;
+    capacity_ = new_capacity;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void SmallVector<T, N, Alloc, Growth>::release_heap() noexcept
+{
+    if (!is_inline()) alloc_traits::deallocate(alloc_, array_, capacity_);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void SmallVector<T, N, Alloc, Growth>::clear()
+{
+    destroy_n(array_, size_);
+    size_ = 0;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+bool SmallVector<T, N, Alloc, Growth>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+size_t SmallVector<T, N, Alloc, Growth>::size() const noexcept
+{
+    return size_;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+size_t SmallVector<T, N, Alloc, Growth>::capacity() const noexcept
+{
+    return capacity_;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+typename SmallVector<T, N, Alloc, Growth>::allocator_type SmallVector<T, N, Alloc, Growth>::get_allocator() const noexcept
+{
+    return alloc_;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+bool SmallVector<T, N, Alloc, Growth>::is_inline() const noexcept
+{
+    return array_ == reinterpret_cast<const T*>(buffer_);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+T& SmallVector<T, N, Alloc, Growth>::at(size_t index)
+{
+    if (index >= size_) throw std::out_of_range("Index out of range");
+    return array_[index];
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+const T& SmallVector<T, N, Alloc, Growth>::at(size_t index) const
+{
+    if (index >= size_) throw std::out_of_range("Index out of range");
+    return array_[index];
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+T& SmallVector<T, N, Alloc, Growth>::front()
+{
+    if (empty()) throw std::runtime_error("Vector is empty");
+    return array_[0];
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+const T& SmallVector<T, N, Alloc, Growth>::front() const
+{
+    if (empty()) throw std::runtime_error("Vector is empty");
+    return array_[0];
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+T& SmallVector<T, N, Alloc, Growth>::back()
+{
+    if (empty()) throw std::runtime_error("Vector is empty");
+    return array_[size_ - 1];
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+const T& SmallVector<T, N, Alloc, Growth>::back() const
+{
+    if (empty()) throw std::runtime_error("Vector is empty");
+    return array_[size_ - 1];
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+T* SmallVector<T, N, Alloc, Growth>::data()
+{
+    return array_;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+const T* SmallVector<T, N, Alloc, Growth>::data() const noexcept
+{
+    return array_;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+typename SmallVector<T, N, Alloc, Growth>::iterator SmallVector<T, N, Alloc, Growth>::begin() noexcept
+{
+    return array_;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+typename SmallVector<T, N, Alloc, Growth>::const_iterator SmallVector<T, N, Alloc, Growth>::begin() const noexcept
+{
+    return array_;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+typename SmallVector<T, N, Alloc, Growth>::iterator SmallVector<T, N, Alloc, Growth>::end() noexcept
+{
+    return array_ + size_;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+typename SmallVector<T, N, Alloc, Growth>::const_iterator SmallVector<T, N, Alloc, Growth>::end() const noexcept
+{
+    return array_ + size_;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+typename SmallVector<T, N, Alloc, Growth>::const_iterator SmallVector<T, N, Alloc, Growth>::cbegin() const noexcept
+{
+    return array_;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+typename SmallVector<T, N, Alloc, Growth>::const_iterator SmallVector<T, N, Alloc, Growth>::cend() const noexcept
+{
+    return array_ + size_;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+SmallVector<T, N, Alloc, Growth>& SmallVector<T, N, Alloc, Growth>::push_back(const T& value)
+{
+    emplace_back(value);
+    return *this;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void SmallVector<T, N, Alloc, Growth>::pop_back()
+{
+    if (empty()) throw std::runtime_error("Vector is empty");
+    alloc_traits::destroy(alloc_, array_ + size_ - 1);
+    --size_;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void SmallVector<T, N, Alloc, Growth>::reserve(size_t new_capacity)
+{
+    if (new_capacity <= capacity_) return;
+    reallocate(new_capacity);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void SmallVector<T, N, Alloc, Growth>::shrink_to_fit()
+{
+    if (capacity_ == size_ || is_inline()) return;
+    reallocate(size_);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void SmallVector<T, N, Alloc, Growth>::swap(SmallVector& other) noexcept(std::is_nothrow_move_assignable_v<SmallVector>)
+{
+    SmallVector temp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(temp);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+template <typename... Args>
+T& SmallVector<T, N, Alloc, Growth>::emplace_back(Args&&... args)
+{
+    if (size_ == capacity_)
+    {
+        // args may refer to an element of this vector, so build the value before moving the buffer
+        T value(std::forward<Args>(args)...);
+        reallocate(Growth::next_capacity(capacity_, size_ + 1, sizeof(T)));
+        alloc_traits::construct(alloc_, array_ + size_, std::move(value));
+    }
+    else
+    {
+        alloc_traits::construct(alloc_, array_ + size_, std::forward<Args>(args)...);
+    }
+    size_++;
+
+    return array_[size_ - 1];
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void SmallVector<T, N, Alloc, Growth>::resize(size_t count)
+{
+    if (count <= size_)
+    {
+        destroy_n(array_ + count, size_ - count);
+        size_ = count;
+        return;
+    }
+    if (count > capacity_) reallocate(Growth::next_capacity(capacity_, count, sizeof(T)));
+    size_t i = size_;
+    try
+    {
+        for (; i < count; ++i)
+        {
+            alloc_traits::construct(alloc_, array_ + i);
+        }
+    }
+    catch (...)
+    {
+        destroy_n(array_ + size_, i - size_);
+        throw;
+    }
+    size_ = count;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void SmallVector<T, N, Alloc, Growth>::resize(size_t count, const T& value)
+{
+    if (count <= size_)
+    {
+        destroy_n(array_ + count, size_ - count);
+        size_ = count;
+        return;
+    }
+    insert(end(), count - size_, value);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void SmallVector<T, N, Alloc, Growth>::resize_uninitialized(size_t count)
+    requires trivially_default_initializable<T>
+{
+    if (count > capacity_) reallocate(Growth::next_capacity(capacity_, count, sizeof(T)));
+    size_ = count;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void SmallVector<T, N, Alloc, Growth>::assign(size_t count, const T& value)
+{
+    T copy(value);
+    clear();
+    // with no elements left, reallocating only swaps the buffer
+    reserve(count);
+    fill_construct(array_, count, copy);
+    size_ = count;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+template <std::input_iterator InputIt>
+void SmallVector<T, N, Alloc, Growth>::assign(InputIt first, InputIt last)
+{
+    clear();
+    if constexpr (std::forward_iterator<InputIt>)
+    {
+        size_t count = static_cast<size_t>(std::distance(first, last));
+        reserve(count);
+        copy_construct(array_, first, count);
+        size_ = count;
+    }
+    else
+    {
+        for (; first != last; ++first) emplace_back(*first);
+    }
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void SmallVector<T, N, Alloc, Growth>::assign(std::initializer_list<T> init)
+{
+    assign(init.begin(), init.end());
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+typename SmallVector<T, N, Alloc, Growth>::iterator SmallVector<T, N, Alloc, Growth>::insert(const_iterator pos, const T& value)
+{
+    return insert(pos, 1, value);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+typename SmallVector<T, N, Alloc, Growth>::iterator SmallVector<T, N, Alloc, Growth>::insert(const_iterator pos, size_t count, const T& value)
+{
+    // value may live in this vector and be moved by the insertion
+    T copy(value);
+    return insert_n(static_cast<size_t>(pos - array_), count, [&](T* gap) { fill_construct(gap, count, copy); });
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+template <std::input_iterator InputIt>
+typename SmallVector<T, N, Alloc, Growth>::iterator SmallVector<T, N, Alloc, Growth>::insert(const_iterator pos, InputIt first, InputIt last)
+{
+    size_t index = static_cast<size_t>(pos - array_);
+    if constexpr (std::forward_iterator<InputIt>)
+    {
+        size_t count = static_cast<size_t>(std::distance(first, last));
+        return insert_n(index, count, [&](T* gap) { copy_construct(gap, first, count); });
+    }
+    else
+    {
+        size_t old_size = size_;
+        for (; first != last; ++first) emplace_back(*first);
+        std::rotate(array_ + index, array_ + old_size, array_ + size_);
+        return array_ + index;
+    }
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+typename SmallVector<T, N, Alloc, Growth>::iterator SmallVector<T, N, Alloc, Growth>::insert(const_iterator pos, std::initializer_list<T> init)
+{
+    return insert(pos, init.begin(), init.end());
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+template <std::input_iterator InputIt>
+void SmallVector<T, N, Alloc, Growth>::append(InputIt first, InputIt last)
+{
+    insert(cend(), first, last);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+template <std::ranges::input_range Range>
+void SmallVector<T, N, Alloc, Growth>::append(Range&& range)
+{
+    if constexpr (std::ranges::forward_range<Range> && std::ranges::sized_range<Range>)
+    {
+        size_t count = static_cast<size_t>(std::ranges::size(range));
+        insert_n(size_, count, [&](T* gap) { copy_construct(gap, std::ranges::begin(range), count); });
+    }
+    else
+    {
+        for (auto first = std::ranges::begin(range); first != std::ranges::end(range); ++first) emplace_back(*first);
+    }
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void SmallVector<T, N, Alloc, Growth>::fill(const T& value)
+{
+    simd::fill(array_, size_, value);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+typename SmallVector<T, N, Alloc, Growth>::iterator SmallVector<T, N, Alloc, Growth>::find(const T& value)
+{
+    return array_ + simd::find(static_cast<const T*>(array_), size_, value);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+typename SmallVector<T, N, Alloc, Growth>::const_iterator SmallVector<T, N, Alloc, Growth>::find(const T& value) const
+{
+    return array_ + simd::find(static_cast<const T*>(array_), size_, value);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+size_t SmallVector<T, N, Alloc, Growth>::count(const T& value) const
+{
+    return simd::count(static_cast<const T*>(array_), size_, value);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+T SmallVector<T, N, Alloc, Growth>::min() const
+{
+    if (empty()) throw std::runtime_error("Vector is empty");
+    return simd::min(static_cast<const T*>(array_), size_);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+T SmallVector<T, N, Alloc, Growth>::max() const
+{
+    if (empty()) throw std::runtime_error("Vector is empty");
+    return simd::max(static_cast<const T*>(array_), size_);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+T& SmallVector<T, N, Alloc, Growth>::operator[](size_t index)
+{
+    return array_[index];
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+const T& SmallVector<T, N, Alloc, Growth>::operator[](size_t index) const
+{
+    return array_[index];
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+bool SmallVector<T, N, Alloc, Growth>::operator==(const SmallVector& other) const
+{
+    if (size_ != other.size_) return false;
+    return simd::equal(static_cast<const T*>(array_), static_cast<const T*>(other.array_), size_);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+bool SmallVector<T, N, Alloc, Growth>::operator!=(const SmallVector& other) const
+{
+    return !(*this == other);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+SmallVector<T, N, Alloc, Growth>& SmallVector<T, N, Alloc, Growth>::operator=(const SmallVector& other)
+{
+    if (this != &other)
+    {
+        clear();
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+        {
+            if (alloc_ != other.alloc_)
+            {
+                release_heap();
+                array_ = inline_data();
+                capacity_ = N;
+            }
+            alloc_ = other.alloc_;
+        }
+
+        reserve(other.size_);
+        for (; size_ < other.size_; ++size_)
+        {
+            alloc_traits::construct(alloc_, array_ + size_, other.array_[size_]);
+        }
+    }
+    return *this;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+SmallVector<T, N, Alloc, Growth>& SmallVector<T, N, Alloc, Growth>::operator=(SmallVector&& other) noexcept(
+    (std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value ||
+     std::allocator_traits<Alloc>::is_always_equal::value) &&
+    std::is_nothrow_move_constructible_v<T>)
+{
+    if (this != &other)
+    {
+        clear();
+
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+        {
+            // a heap buffer we keep must be freed by the allocator that is about to be replaced
+            if (!other.is_inline() || alloc_ != other.alloc_)
+            {
+                release_heap();
+                array_ = inline_data();
+                capacity_ = N;
+            }
+            alloc_ = std::move(other.alloc_);
+        }
+        else if constexpr (!alloc_traits::is_always_equal::value)
+        {
+            // memory owned by a different allocator cannot be adopted, move element by element instead
+            if (alloc_ != other.alloc_)
+            {
+                reserve(other.size_);
+                relocate(other.array_, other.size_, array_);
+                size_ = other.size_;
+                other.size_ = 0;
+                return *this;
+            }
+        }
+
+        if (!other.is_inline())
+        {
+            release_heap();
+            array_ = other.array_;
+            capacity_ = other.capacity_;
+            size_ = other.size_;
+            other.array_ = other.inline_data();
+            other.capacity_ = N;
+            other.size_ = 0;
+            return *this;
+        }
+
+        // other's elements fit inline, so they fit whichever buffer we hold
+        relocate(other.array_, other.size_, array_);
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+    return *this;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed set of worker threads fed from one FIFO queue. parallel_for splits an
+// index range into contiguous chunks, one per thread, so a buffer written by it
+// is first touched (and on NUMA machines placed) by the thread that owns each
+// chunk.
+class ThreadPool
+{
+   private:
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    bool stopping_;
+
+    void work();
+
+   public:
+    explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency());
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    // finishes the queued tasks, then joins the workers
+    ~ThreadPool();
+
+    std::size_t size() const noexcept;
+
+    // task must not throw
+    void submit(std::function<void()> task);
+
+    // runs body(begin, end) over [0, count) in chunks of at least grain indices; the
+    // calling thread takes part, so nested calls from inside a task cannot deadlock.
+    // Every chunk runs even if one throws; the first exception is rethrown here.
+    void parallel_for(std::size_t count, std::size_t grain, const std::function<void(std::size_t, std::size_t)>& body);
+
+    // process-wide pool, started on first use; with the caller it uses every hardware thread
+    static ThreadPool& shared();
+};
+
+// Execution policies for the containers' bulk operations: exec::seq runs on the
+// calling thread, exec::par on ThreadPool::shared() or on the pool given to on().
+namespace exec
+{
+struct sequenced_policy
+{
+};
+
+struct parallel_policy
+{
+    ThreadPool* pool = nullptr;
+
+    parallel_policy on(ThreadPool& other) const noexcept { return parallel_policy{&other}; }
+};
+
+inline constexpr sequenced_policy seq{};
+inline constexpr parallel_policy par{};
+
+template <typename Policy>
+concept execution_policy = std::same_as<std::remove_cvref_t<Policy>, sequenced_policy> ||
+                           std::same_as<std::remove_cvref_t<Policy>, parallel_policy>;
+
+template <typename Body>
+void for_each_chunk(sequenced_policy, std::size_t count, std::size_t, Body&& body)
+{
+    if (count) body(std::size_t(0), count);
+}
+
+template <typename Body>
+void for_each_chunk(parallel_policy policy, std::size_t count, std::size_t grain, Body&& body)
+{
+    ThreadPool& pool = policy.pool ? *policy.pool : ThreadPool::shared();
+    pool.parallel_for(count, grain, body);
+}
+}  // namespace exec
@@ -0,0 +1,735 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// elements per node by default: enough to fill a node of about 256 bytes, at least 4
+template <typename T>
+inline constexpr std::size_t default_unrolled_capacity =
+    sizeof(T) * 4 + 3 * sizeof(void*) > 256 ? 4 : (256 - 3 * sizeof(void*)) / sizeof(T);
+
+// A doubly-linked list of small arrays: each node holds up to NodeCap elements, so walking
+// the list touches one node per NodeCap elements instead of one per element. Inserting into
+// a full node splits it in half; a node that an erase leaves sparse takes in its successor
+// when both fit in half a node. Like List, the nodes form a ring through a sentinel.
+//
+// Iterators are a node pointer and an index. insert and erase invalidate iterators into
+// the nodes they touch and return an iterator to the inserted element or to the one after
+// the erased element.
+template <typename T, std::size_t NodeCap = default_unrolled_capacity<T>, typename Alloc = std::allocator<T>>
+class UnrolledList
+{
+    static_assert(NodeCap >= 2, "UnrolledList needs room for at least two elements per node");
+
+   private:
+    struct NodeBase
+    {
+        NodeBase* next;
+        NodeBase* previous;
+        std::size_t count;
+    };
+    struct Node : NodeBase
+    {
+        alignas(T) unsigned char storage[NodeCap * sizeof(T)];
+        Node() : NodeBase{nullptr, nullptr, 0} {}
+    };
+    using node_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using node_traits = std::allocator_traits<node_allocator>;
+
+    [[no_unique_address]] node_allocator alloc_;
+    // the sentinel holds no elements (count 0): sentinel_.next is the first node,
+    // sentinel_.previous the last; no node in the ring is ever empty
+    NodeBase sentinel_{&sentinel_, &sentinel_, 0};
+    std::size_t size_ = 0;
+
+    static T* elements(NodeBase* node) noexcept;
+    static const T* elements(const NodeBase* node) noexcept;
+
+    // a detached node holding a copy of value
+    Node* createNode(const T& value);
+    // destroy the node's elements and free it; the node must be unlinked
+    void destroyNode(NodeBase* node) noexcept;
+    static void linkAfter(NodeBase* position, NodeBase* node) noexcept;
+    static void unlink(NodeBase* node) noexcept;
+    // move the upper half of a full node into a new node linked after it
+    void split(NodeBase* node);
+
+   public:
+    class iterator
+    {
+       private:
+        NodeBase* node_;
+        std::size_t index_;
+
+        friend class UnrolledList;
+        friend class const_iterator;
+
+       public:
+        iterator() : node_(nullptr), index_(0) {}
+        explicit iterator(NodeBase* node, std::size_t index) : node_(node), index_(index) {}
+
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator& operator++();
+        iterator operator++(int);
+        iterator& operator--();
+        iterator operator--(int);
+        bool operator==(const iterator& right) const;
+        bool operator!=(const iterator& right) const;
+        T& operator*() const;
+        T* operator->() const;
+    };
+
+    class const_iterator
+    {
+       private:
+        const NodeBase* node_;
+        std::size_t index_;
+
+       public:
+        const_iterator() : node_(nullptr), index_(0) {}
+        explicit const_iterator(const NodeBase* node, std::size_t index) : node_(node), index_(index) {}
+        const_iterator(const iterator& other);
+
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = const T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator& operator++();
+        const_iterator operator++(int);
+        const_iterator& operator--();
+        const_iterator operator--(int);
+        bool operator==(const const_iterator& right) const;
+        bool operator!=(const const_iterator& right) const;
+        const T& operator*() const;
+        const T* operator->() const;
+    };
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using allocator_type = Alloc;
+
+    UnrolledList();
+    explicit UnrolledList(const Alloc& alloc);
+    UnrolledList(std::size_t size, const Alloc& alloc = Alloc());
+    UnrolledList(int size, const T& value, const Alloc& alloc = Alloc());
+    UnrolledList(const UnrolledList& copy);
+    UnrolledList(std::initializer_list<T> init, const Alloc& alloc = Alloc());
+    template <typename inputIt>
+    UnrolledList(inputIt begin, inputIt end, const Alloc& alloc = Alloc());
+    ~UnrolledList();
+
+    allocator_type get_allocator() const noexcept;
+
+    const_reverse_iterator crbegin() const;
+    const_reverse_iterator crend() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    reverse_iterator rbegin();
+    reverse_iterator rend();
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    bool empty() const noexcept;
+    std::size_t size() const noexcept;
+    const T& front() const;
+    T& front();
+    const T& back() const;
+    T& back();
+
+    iterator insert(const iterator& it, const T& value);
+    iterator erase(const iterator& it);
+
+    void push_back(const T& value);
+    void push_front(const T& value);
+    void pop_front();
+    void pop_back();
+    void clear();
+
+    bool operator==(const UnrolledList& right) const;
+    bool operator!=(const UnrolledList& right) const;
+    UnrolledList& operator=(const UnrolledList& right);
+};
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+T* UnrolledList<T, NodeCap, Alloc>::elements(NodeBase* node) noexcept
+{
+    return std::launder(reinterpret_cast<T*>(static_cast<Node*>(node)->storage));
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+const T* UnrolledList<T, NodeCap, Alloc>::elements(const NodeBase* node) noexcept
+{
+    return std::launder(reinterpret_cast<const T*>(static_cast<const Node*>(node)->storage));
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::Node* UnrolledList<T, NodeCap, Alloc>::createNode(const T& value)
+{
+    Node* node = node_traits::allocate(alloc_, 1);
+    try
+    {
+        node_traits::construct(alloc_, node);
+        node_traits::construct(alloc_, elements(node), value);
+    }
+    catch (...)
+    {
+        node_traits::deallocate(alloc_, node, 1);
+        throw;
+    }
+    node->count = 1;
+    return node;
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+void UnrolledList<T, NodeCap, Alloc>::destroyNode(NodeBase* node) noexcept
+{
+    T* data = elements(node);
+    for (std::size_t i = 0; i < node->count; ++i) node_traits::destroy(alloc_, data + i);
+    node_traits::destroy(alloc_, static_cast<Node*>(node));
+    node_traits::deallocate(alloc_, static_cast<Node*>(node), 1);
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+void UnrolledList<T, NodeCap, Alloc>::linkAfter(NodeBase* position, NodeBase* node) noexcept
+{
+    node->previous = position;
+    node->next = position->next;
+    position->next->previous = node;
+    position->next = node;
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+void UnrolledList<T, NodeCap, Alloc>::unlink(NodeBase* node) noexcept
+{
+    node->previous->next = node->next;
+    node->next->previous = node->previous;
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+void UnrolledList<T, NodeCap, Alloc>::split(NodeBase* node)
+{
+    constexpr std::size_t half = NodeCap / 2;
+    T* from = elements(node);
+
+    Node* fresh = node_traits::allocate(alloc_, 1);
+    node_traits::construct(alloc_, fresh);
+    T* to = elements(fresh);
+    try
+    {
+        // copies instead of moves if moving could throw, so a failure leaves node intact
+        for (std::size_t i = half; i < NodeCap; ++i)
+        {
+            node_traits::construct(alloc_, to + fresh->count, std::move_if_noexcept(from[i]));
+            ++fresh->count;
+        }
+    }
+    catch (...)
+    {
+        destroyNode(fresh);
+        throw;
+    }
+    for (std::size_t i = half; i < NodeCap; ++i) node_traits::destroy(alloc_, from + i);
+    node->count = half;
+    linkAfter(node, fresh);
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::iterator UnrolledList<T, NodeCap, Alloc>::insert(const iterator& it,
+                                                                                         const T& value)
+{
+    NodeBase* node = it.node_;
+    std::size_t index = it.index_;
+
+    // end() appends to the last node
+    if (node == &sentinel_)
+    {
+        node = sentinel_.previous;
+        index = node->count;
+    }
+
+    // appending to a full node (or to no node at all) starts a new node after it
+    if (index == node->count && (node == &sentinel_ || node->count == NodeCap))
+    {
+        Node* fresh = createNode(value);
+        linkAfter(node, fresh);
+        ++size_;
+        return iterator(fresh, 0);
+    }
+
+    if (index == 0 && node->count == NodeCap)
+    {
+        // in front of a full node: append to the previous node if it has room, else start a new one
+        NodeBase* before = node->previous;
+        if (before == &sentinel_ || before->count == NodeCap)
+        {
+            Node* fresh = createNode(value);
+            linkAfter(before, fresh);
+            ++size_;
+            return iterator(fresh, 0);
+        }
+        node = before;
+        index = before->count;
+    }
+
+    if (index == node->count)
+    {
+        node_traits::construct(alloc_, elements(node) + index, value);
+        ++node->count;
+        ++size_;
+        return iterator(node, index);
+    }
+
+    // elements are about to move, and value may be one of them
+    T temp(value);
+    if (node->count == NodeCap)
+    {
+        split(node);
+        if (index > node->count)
+        {
+            index -= node->count;
+            node = node->next;
+        }
+    }
+
+    T* data = elements(node);
+    std::size_t count = node->count;
+    if (index == count)
+    {
+        node_traits::construct(alloc_, data + count, std::move(temp));
+    }
+    else
+    {
+        node_traits::construct(alloc_, data + count, std::move(data[count - 1]));
+        std::move_backward(data + index, data + count - 1, data + count);
+        data[index] = std::move(temp);
+    }
+    ++node->count;
+    ++size_;
+    return iterator(node, index);
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::iterator UnrolledList<T, NodeCap, Alloc>::erase(const iterator& it)
+{
+    NodeBase* node = it.node_;
+    std::size_t index = it.index_;
+    if (node == &sentinel_) return end();
+
+    T* data = elements(node);
+    std::move(data + index + 1, data + node->count, data + index);
+    node_traits::destroy(alloc_, data + node->count - 1);
+    --node->count;
+    --size_;
+
+    NodeBase* next = node->next;
+    if (node->count == 0)
+    {
+        unlink(node);
+        destroyNode(node);
+        return iterator(next, 0);
+    }
+
+    // fold the successor in while both fit in half a node, so erasures cannot leave a trail of
+    // nearly empty nodes; only with non-throwing moves, since a half-done merge cannot be undone
+    if constexpr (std::is_nothrow_move_constructible_v<T>)
+    {
+        if (next != &sentinel_ && node->count + next->count <= NodeCap / 2)
+        {
+            T* source = elements(next);
+            for (std::size_t i = 0; i < next->count; ++i)
+            {
+                node_traits::construct(alloc_, data + node->count, std::move(source[i]));
+                ++node->count;
+            }
+            unlink(next);
+            destroyNode(next);
+        }
+    }
+
+    if (index == node->count) return iterator(node->next, 0);
+    return iterator(node, index);
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::iterator& UnrolledList<T, NodeCap, Alloc>::iterator::operator++()
+{
+    if (++index_ == node_->count)
+    {
+        node_ = node_->next;
+        index_ = 0;
+    }
+    return *this;
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::iterator UnrolledList<T, NodeCap, Alloc>::iterator::operator++(int)
+{
+    iterator temp = *this;
+    ++(*this);
+    return temp;
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::iterator& UnrolledList<T, NodeCap, Alloc>::iterator::operator--()
+{
+    if (index_ == 0)
+    {
+        node_ = node_->previous;
+        index_ = node_->count;
+    }
+    --index_;
+    return *this;
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::iterator UnrolledList<T, NodeCap, Alloc>::iterator::operator--(int)
+{
+    iterator temp = *this;
+    --(*this);
+    return temp;
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+bool UnrolledList<T, NodeCap, Alloc>::iterator::operator==(const iterator& right) const
+{
+    return node_ == right.node_ && index_ == right.index_;
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+bool UnrolledList<T, NodeCap, Alloc>::iterator::operator!=(const iterator& right) const
+{
+    return !(*this == right);
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+T& UnrolledList<T, NodeCap, Alloc>::iterator::operator*() const
+{
+    return elements(node_)[index_];
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+T* UnrolledList<T, NodeCap, Alloc>::iterator::operator->() const
+{
+    return elements(node_) + index_;
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+UnrolledList<T, NodeCap, Alloc>::const_iterator::const_iterator(const iterator& other)
+    : node_(other.node_), index_(other.index_)
+{
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::const_iterator& UnrolledList<T, NodeCap, Alloc>::const_iterator::operator++()
+{
+    if (++index_ == node_->count)
+    {
+        node_ = node_->next;
+        index_ = 0;
+    }
+    return *this;
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::const_iterator UnrolledList<T, NodeCap, Alloc>::const_iterator::operator++(int)
+{
+    const_iterator temp = *this;
+    ++(*this);
+    return temp;
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::const_iterator& UnrolledList<T, NodeCap, Alloc>::const_iterator::operator--()
+{
+    if (index_ == 0)
+    {
+        node_ = node_->previous;
+        index_ = node_->count;
+    }
+    --index_;
+    return *this;
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::const_iterator UnrolledList<T, NodeCap, Alloc>::const_iterator::operator--(int)
+{
+    const_iterator temp = *this;
+    --(*this);
+    return temp;
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+bool UnrolledList<T, NodeCap, Alloc>::const_iterator::operator==(const const_iterator& right) const
+{
+    return node_ == right.node_ && index_ == right.index_;
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+bool UnrolledList<T, NodeCap, Alloc>::const_iterator::operator!=(const const_iterator& right) const
+{
+    return !(*this == right);
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+const T& UnrolledList<T, NodeCap, Alloc>::const_iterator::operator*() const
+{
+    return elements(node_)[index_];
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+const T* UnrolledList<T, NodeCap, Alloc>::const_iterator::operator->() const
+{
+    return elements(node_) + index_;
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+UnrolledList<T, NodeCap, Alloc>::UnrolledList() : UnrolledList(Alloc())
+{
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+UnrolledList<T, NodeCap, Alloc>::UnrolledList(const Alloc& alloc) : alloc_(alloc)
+{
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+UnrolledList<T, NodeCap, Alloc>::UnrolledList(std::size_t size, const Alloc& alloc) : alloc_(alloc)
+{
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        push_back(T());
+    }
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+UnrolledList<T, NodeCap, Alloc>::UnrolledList(int size, const T& value, const Alloc& alloc) : alloc_(alloc)
+{
+    for (int i = 0; i < size; ++i)
+    {
+        push_back(value);
+    }
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+UnrolledList<T, NodeCap, Alloc>::UnrolledList(const UnrolledList& copy)
+    : alloc_(node_traits::select_on_container_copy_construction(copy.alloc_))
+{
+    for (const T& value : copy)
+    {
+        push_back(value);
+    }
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+UnrolledList<T, NodeCap, Alloc>::UnrolledList(std::initializer_list<T> init, const Alloc& alloc) : alloc_(alloc)
+{
+    for (const T& value : init)
+    {
+        push_back(value);
+    }
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+template <typename inputIt>
+UnrolledList<T, NodeCap, Alloc>::UnrolledList(inputIt begin, inputIt end, const Alloc& alloc) : alloc_(alloc)
+{
+    while (begin != end)
+    {
+        push_back(*begin);
+        ++begin;
+    }
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+UnrolledList<T, NodeCap, Alloc>::~UnrolledList()
+{
+    clear();
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::allocator_type UnrolledList<T, NodeCap, Alloc>::get_allocator() const noexcept
+{
+    return Alloc(alloc_);
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::const_reverse_iterator UnrolledList<T, NodeCap, Alloc>::crbegin() const
+{
+    return const_reverse_iterator(cend());
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::const_reverse_iterator UnrolledList<T, NodeCap, Alloc>::crend() const
+{
+    return const_reverse_iterator(cbegin());
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::const_iterator UnrolledList<T, NodeCap, Alloc>::cbegin() const
+{
+    return const_iterator(sentinel_.next, 0);
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::const_iterator UnrolledList<T, NodeCap, Alloc>::cend() const
+{
+    return const_iterator(&sentinel_, 0);
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::reverse_iterator UnrolledList<T, NodeCap, Alloc>::rbegin()
+{
+    return reverse_iterator(end());
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::reverse_iterator UnrolledList<T, NodeCap, Alloc>::rend()
+{
+    return reverse_iterator(begin());
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::iterator UnrolledList<T, NodeCap, Alloc>::begin()
+{
+    return iterator(sentinel_.next, 0);
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::iterator UnrolledList<T, NodeCap, Alloc>::end()
+{
+    return iterator(&sentinel_, 0);
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::const_iterator UnrolledList<T, NodeCap, Alloc>::begin() const
+{
+    return cbegin();
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+typename UnrolledList<T, NodeCap, Alloc>::const_iterator UnrolledList<T, NodeCap, Alloc>::end() const
+{
+    return cend();
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+bool UnrolledList<T, NodeCap, Alloc>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+std::size_t UnrolledList<T, NodeCap, Alloc>::size() const noexcept
+{
+    return size_;
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+const T& UnrolledList<T, NodeCap, Alloc>::front() const
+{
+    if (!size_) throw std::out_of_range("List is empty");
+    return elements(sentinel_.next)[0];
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+T& UnrolledList<T, NodeCap, Alloc>::front()
+{
+    if (!size_) throw std::out_of_range("List is empty");
+    return elements(sentinel_.next)[0];
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+const T& UnrolledList<T, NodeCap, Alloc>::back() const
+{
+    if (!size_) throw std::out_of_range("List is empty");
+    return elements(sentinel_.previous)[sentinel_.previous->count - 1];
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+T& UnrolledList<T, NodeCap, Alloc>::back()
+{
+    if (!size_) throw std::out_of_range("List is empty");
+    return elements(sentinel_.previous)[sentinel_.previous->count - 1];
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+void UnrolledList<T, NodeCap, Alloc>::push_back(const T& value)
+{
+    insert(end(), value);
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+void UnrolledList<T, NodeCap, Alloc>::push_front(const T& value)
+{
+    insert(begin(), value);
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+void UnrolledList<T, NodeCap, Alloc>::pop_front()
+{
+    if (!size_) return;
+    erase(begin());
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+void UnrolledList<T, NodeCap, Alloc>::pop_back()
+{
+    if (!size_) return;
+    erase(iterator(sentinel_.previous, sentinel_.previous->count - 1));
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+void UnrolledList<T, NodeCap, Alloc>::clear()
+{
+    NodeBase* node = sentinel_.next;
+    while (node != &sentinel_)
+    {
+        NodeBase* next = node->next;
+        destroyNode(node);
+        node = next;
+    }
+    sentinel_.next = sentinel_.previous = &sentinel_;
+    size_ = 0;
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+bool UnrolledList<T, NodeCap, Alloc>::operator==(const UnrolledList& right) const
+{
+    return size_ == right.size_ && std::equal(begin(), end(), right.begin());
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+bool UnrolledList<T, NodeCap, Alloc>::operator!=(const UnrolledList& right) const
+{
+    return !(*this == right);
+}
+
+template <typename T, std::size_t NodeCap, typename Alloc>
+UnrolledList<T, NodeCap, Alloc>& UnrolledList<T, NodeCap, Alloc>::operator=(const UnrolledList& right)
+{
+    if (this == &right) return *this;
+    clear();
+    if constexpr (node_traits::propagate_on_container_copy_assignment::value) alloc_ = right.alloc_;
+
+    for (const T& value : right)
+    {
+        push_back(value);
+    }
+    return *this;
+}
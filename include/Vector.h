@@ -1,28 +1,72 @@
 #pragma once
 
+#include <algorithm>
+#include <concepts>
 #include <cstddef>
+#include <cstring>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <ranges>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "GrowthPolicy.h"
+#include "Simd.h"
+#include "ThreadPool.h"
 
+// Types whose objects can be moved to new storage with memcpy, leaving the
+// source as raw memory that needs no destructor call. Specialize for types
+// that are not trivially copyable but still relocatable (e.g. owning handles).
 template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T>
+{
+};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// Types whose default-initialized objects need neither construction nor destruction, so
+// a buffer can be handed out (e.g. to read()) without first being written.
+template <typename T>
+concept trivially_default_initializable =
+    std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>;
+
+// Tag selecting default-initialization: the elements are left indeterminate instead of zeroed.
+struct default_init_t
+{
+    explicit default_init_t() = default;
+};
+inline constexpr default_init_t default_init{};
+
+template <typename T, typename Alloc = std::allocator<T>, typename Growth = PowerOfTwoGrowth>
 class Vector
 {
    public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using iterator = T*;
+    using const_iterator = const T*;
+
     Vector();
-    explicit Vector(size_t size);
+    explicit Vector(const Alloc& alloc);
+    explicit Vector(size_t size, const Alloc& alloc = Alloc());
+    Vector(size_t size, default_init_t, const Alloc& alloc = Alloc())
+        requires trivially_default_initializable<T>;
     Vector(const Vector& other);
     Vector(Vector&& other) noexcept;
-    Vector(size_t size, const T& value);
-    Vector(std::initializer_list<T> init);
+    Vector(size_t size, const T& value, const Alloc& alloc = Alloc());
+    Vector(std::initializer_list<T> init, const Alloc& alloc = Alloc());
     ~Vector() noexcept;
 
     void clear();
     bool empty() const noexcept;
     size_t size() const noexcept;
     size_t capacity() const noexcept;
+    allocator_type get_allocator() const noexcept;
 
     T& at(size_t index);
     const T& at(size_t index) const;
@@ -36,6 +80,13 @@ class Vector
     T* data();
 	const T* data() const noexcept;
 
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
     Vector& push_back(const T& value);
     void pop_back();
 
@@ -47,230 +98,568 @@ class Vector
     template <typename... Args>
     T& emplace_back(Args&&... args);
 
+    void resize(size_t count);
+    void resize(size_t count, const T& value);
+    // grow without writing the new elements; their values are indeterminate until assigned
+    void resize_uninitialized(size_t count)
+        requires trivially_default_initializable<T>;
+
+    void assign(size_t count, const T& value);
+    template <std::input_iterator InputIt>
+    void assign(InputIt first, InputIt last);
+    void assign(std::initializer_list<T> init);
+
+    // bulk insertion: for forward ranges the capacity is computed once and the
+    // elements are constructed in a single pass (memcpy for trivially copyable T)
+    iterator insert(const_iterator pos, const T& value);
+    iterator insert(const_iterator pos, size_t count, const T& value);
+    template <std::input_iterator InputIt>
+    iterator insert(const_iterator pos, InputIt first, InputIt last);
+    iterator insert(const_iterator pos, std::initializer_list<T> init);
+
+    template <std::input_iterator InputIt>
+    void append(InputIt first, InputIt last);
+    template <std::ranges::input_range Range>
+    void append(Range&& range);
+
+    // scans; integral and floating T use the vectorized kernels from Simd.h
+    void fill(const T& value);
+    iterator find(const T& value);
+    const_iterator find(const T& value) const;
+    size_t count(const T& value) const;
+    T min() const;
+    T max() const;
+
+    // execution-policy overloads (exec::seq, exec::par). copy_from and transform replace the
+    // contents with a fresh buffer whose elements are constructed by the thread owning each
+    // chunk, so with exec::par the pages of a large vector are first touched across the pool
+    template <exec::execution_policy Policy, std::random_access_iterator It>
+    void copy_from(Policy&& policy, It first, It last);
+    template <exec::execution_policy Policy, std::random_access_iterator It, typename UnaryOp>
+    void transform(Policy&& policy, It first, It last, UnaryOp op);
+    template <exec::execution_policy Policy>
+    void fill(Policy&& policy, const T& value);
+
    public:
     T& operator[](size_t index);
     const T& operator[](size_t index) const;
     bool operator==(const Vector& other) const;
     bool operator!=(const Vector& other) const;
     Vector& operator=(const Vector& other);
-    Vector& operator=(Vector&& other) noexcept;
+    Vector& operator=(Vector&& other) noexcept(std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value ||
+                                               std::allocator_traits<Alloc>::is_always_equal::value);
 
    private:
+    using alloc_traits = std::allocator_traits<Alloc>;
+
     T* allocate(size_t start);
+    void deallocate(T* array, size_t capacity) noexcept;
+
+    // allocators exposing reallocate() (MallocAllocator) can grow trivially relocatable buffers in place
+    static constexpr bool reallocates_in_place = is_trivially_relocatable_v<T> && requires(Alloc& alloc, T* array) {
+        { alloc.reallocate(array, size_t(), size_t()) } -> std::same_as<T*>;
+    };
+
+    // move (or copy, if moving may throw) count elements into uninitialized memory;
+    // on failure the partially built destination is destroyed and the source is untouched
+    void move_construct(T* from, size_t count, T* to);
+    // move_construct, then destroy the originals
+    void relocate(T* from, size_t count, T* to);
+    void reallocate(size_t new_capacity);
+
+    // copy count elements starting at first into uninitialized memory, all or nothing
+    template <typename It>
+    void copy_construct(T* to, It first, size_t count);
+    void fill_construct(T* to, size_t count, const T& value);
+
+    // open a gap of count elements at index and let construct(T* gap) fill it
+    template <typename Construct>
+    iterator insert_n(size_t index, size_t count, Construct construct);
 
     // init with default constructor
     void init_default(size_t start, size_t end);
 
+    void destroy_n(T* first, size_t count) noexcept;
+
     // free allocated memory
     void delete_array(size_t start, size_t end);
 
-    size_t geq_power_of_two(size_t n);
+    // capacity to reallocate to when at least required elements must fit
+    size_t grow_capacity(size_t required) const;
+
+    // smallest slice worth handing to another thread
+    static constexpr size_t parallel_grain = sizeof(T) < 4096 ? (size_t(1) << 16) / sizeof(T) : 16;
+
+    // replace the contents with count elements built chunk by chunk by
+    // construct(T* to, size_t begin, size_t end), which must be all or nothing per chunk
+    template <typename Policy, typename ConstructChunk>
+    void build(Policy&& policy, size_t count, ConstructChunk construct);
 
    private:
+    [[no_unique_address]] Alloc alloc_;
     size_t capacity_;
     size_t size_;
     T* array_;
 };
 
-template <typename T>
-Vector<T>::Vector() : capacity_(1), size_(0), array_(allocate(capacity_))
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>::Vector() : Vector(Alloc())
 {
 }
 
-template <typename T>
-Vector<T>::Vector(size_t size, const T& value)
-    : capacity_(geq_power_of_two(size)), size_(size), array_(allocate(capacity_))
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>::Vector(const Alloc& alloc) : alloc_(alloc), capacity_(0), size_(0), array_(nullptr)
 {
-    for (size_t i = 0; i < size; i++)
+}
+
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>::Vector(size_t size, const T& value, const Alloc& alloc)
+    : alloc_(alloc), capacity_(Growth::next_capacity(0, size, sizeof(T))), size_(0), array_(allocate(capacity_))
+{
+    try
+    {
+        fill_construct(array_, size, value);
+        size_ = size;
+    }
+    catch (...)
     {
-        array_[i] = value;
+        deallocate(array_, capacity_);
+        throw;
     }
 }
 
-template <typename T>
-T* Vector<T>::allocate(size_t size)
+template <typename T, typename Alloc, typename Growth>
+T* Vector<T, Alloc, Growth>::allocate(size_t size)
 {
-    return reinterpret_cast<T*>(new char[sizeof(T) * size]);
+    return size ? alloc_traits::allocate(alloc_, size) : nullptr;
 }
 
-template <typename T>
-size_t Vector<T>::size() const noexcept
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::deallocate(T* array, size_t capacity) noexcept
+{
+    if (array) alloc_traits::deallocate(alloc_, array, capacity);
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::move_construct(T* from, size_t count, T* to)
+{
+    if constexpr (is_trivially_relocatable_v<T>)
+    {
+        if (count) std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+        return;
+    }
+
+    size_t i = 0;
+    try
+    {
+        for (; i < count; i++)
+        {
+            alloc_traits::construct(alloc_, to + i, std::move_if_noexcept(from[i]));
+        }
+    }
+    catch (...)
+    {
+        destroy_n(to, i);
+        throw;
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::relocate(T* from, size_t count, T* to)
+{
+    move_construct(from, count, to);
+    // a memcpy'd source is raw memory now, there is nothing left to destroy
+    if constexpr (!is_trivially_relocatable_v<T>) destroy_n(from, count);
+}
+
+template <typename T, typename Alloc, typename Growth>
+template <typename It>
+void Vector<T, Alloc, Growth>::copy_construct(T* to, It first, size_t count)
+{
+    if constexpr (std::contiguous_iterator<It> && std::is_same_v<std::iter_value_t<It>, T> &&
+                  std::is_trivially_copyable_v<T>)
+    {
+        if (count) std::memcpy(static_cast<void*>(to), static_cast<const void*>(std::to_address(first)), count * sizeof(T));
+        return;
+    }
+
+    size_t i = 0;
+    try
+    {
+        for (; i < count; ++i, ++first)
+        {
+            alloc_traits::construct(alloc_, to + i, *first);
+        }
+    }
+    catch (...)
+    {
+        destroy_n(to, i);
+        throw;
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::fill_construct(T* to, size_t count, const T& value)
+{
+    if constexpr (simd::vectorizable_v<T>)
+    {
+        simd::fill(to, count, value);
+        return;
+    }
+    size_t i = 0;
+    try
+    {
+        for (; i < count; ++i)
+        {
+            alloc_traits::construct(alloc_, to + i, value);
+        }
+    }
+    catch (...)
+    {
+        destroy_n(to, i);
+        throw;
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+template <typename Construct>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::insert_n(size_t index, size_t count,
+                                                                               Construct construct)
+{
+    if (count == 0) return array_ + index;
+
+    if (size_ + count > capacity_)
+    {
+        // build the new buffer around the inserted block, the old one stays intact until everything succeeded
+        size_t new_capacity = grow_capacity(size_ + count);
+        T* new_array = allocate(new_capacity);
+        try
+        {
+            construct(new_array + index);
+        }
+        catch (...)
+        {
+            deallocate(new_array, new_capacity);
+            throw;
+        }
+        try
+        {
+            move_construct(array_, index, new_array);
+        }
+        catch (...)
+        {
+            destroy_n(new_array + index, count);
+            deallocate(new_array, new_capacity);
+            throw;
+        }
+        try
+        {
+            move_construct(array_ + index, size_ - index, new_array + index + count);
+        }
+        catch (...)
+        {
+            destroy_n(new_array, index + count);
+            deallocate(new_array, new_capacity);
+            throw;
+        }
+        if constexpr (!is_trivially_relocatable_v<T>) destroy_n(array_, size_);
+        deallocate(array_, capacity_);
+        array_ = new_array;
+        capacity_ = new_capacity;
+    }
+    else if constexpr (is_trivially_relocatable_v<T>)
+    {
+        T* gap = array_ + index;
+        std::memmove(static_cast<void*>(gap + count), static_cast<const void*>(gap), (size_ - index) * sizeof(T));
+        try
+        {
+            construct(gap);
+        }
+        catch (...)
+        {
+            std::memmove(static_cast<void*>(gap), static_cast<const void*>(gap + count), (size_ - index) * sizeof(T));
+            throw;
+        }
+    }
+    else
+    {
+        // construct at the end, then rotate the block into place
+        construct(array_ + size_);
+        std::rotate(array_ + index, array_ + size_, array_ + size_ + count);
+    }
+    size_ += count;
+    return array_ + index;
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::reallocate(size_t new_capacity)
+{
+    if constexpr (reallocates_in_place)
+    {
+        if (array_ && new_capacity)
+        {
+            array_ = alloc_.reallocate(array_, capacity_, new_capacity);
+            capacity_ = new_capacity;
+            return;
+        }
+    }
+
+    T* new_array = allocate(new_capacity);
+    try
+    {
+        relocate(array_, size_, new_array);
+    }
+    catch (...)
+    {
+        deallocate(new_array, new_capacity);
+        throw;
+    }
+    deallocate(array_, capacity_);
+    array_ = new_array;
+    capacity_ = new_capacity;
+}
+
+template <typename T, typename Alloc, typename Growth>
+size_t Vector<T, Alloc, Growth>::size() const noexcept
 {
     return size_;
 }
 
-template <typename T>
-size_t Vector<T>::capacity() const noexcept
+template <typename T, typename Alloc, typename Growth>
+size_t Vector<T, Alloc, Growth>::capacity() const noexcept
 {
     return capacity_;
 }
 
-template <typename T>
-void Vector<T>::init_default(size_t start, size_t end)
+template <typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::allocator_type Vector<T, Alloc, Growth>::get_allocator() const noexcept
 {
-    for (size_t i = start; i < end; ++i)
+    return alloc_;
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::init_default(size_t start, size_t end)
+{
+    size_t i = start;
+    try
+    {
+        for (; i < end; ++i)
+        {
+            alloc_traits::construct(alloc_, array_ + i);
+        }
+    }
+    catch (...)
     {
-        new (array_ + i) T();
+        destroy_n(array_ + start, i - start);
+        throw;
     }
 }
 
-template <typename T>
-void Vector<T>::delete_array(size_t start, size_t end)
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::destroy_n(T* first, size_t count) noexcept
 {
-    for (size_t i = start; i < end; ++i)
+    if constexpr (std::is_trivially_destructible_v<T>) return;
+
+    for (size_t i = 0; i < count; ++i)
     {
-        array_[i].~T();
+        alloc_traits::destroy(alloc_, first + i);
     }
 }
 
-template <typename T>
-void Vector<T>::clear()
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::delete_array(size_t start, size_t end)
+{
+    destroy_n(array_ + start, end - start);
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::clear()
 {
     delete_array(0, size_);
     size_ = 0;
 }
 
-template <typename T>
-Vector<T>::~Vector() noexcept
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>::~Vector() noexcept
 {
     clear();
-    delete[] reinterpret_cast<char*>(array_);
+    deallocate(array_, capacity_);
 }
 
-template <typename T>
-size_t Vector<T>::geq_power_of_two(size_t size)
+template <typename T, typename Alloc, typename Growth>
+size_t Vector<T, Alloc, Growth>::grow_capacity(size_t required) const
 {
-    size_t cap = 1;
-    while (cap < size) cap *= 2;
-    return cap;
+    return Growth::next_capacity(capacity_, required, sizeof(T));
 }
 
-template <typename T>
-Vector<T>::Vector(size_t size) : capacity_(geq_power_of_two(size)), size_(size), array_(allocate(capacity_))
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>::Vector(size_t size, const Alloc& alloc)
+    : alloc_(alloc), capacity_(Growth::next_capacity(0, size, sizeof(T))), size_(0), array_(allocate(capacity_))
 {
-    init_default(0, size_);
+    try
+    {
+        init_default(0, size);
+        size_ = size;
+    }
+    catch (...)
+    {
+        deallocate(array_, capacity_);
+        throw;
+    }
 }
 
-template <typename T>
-Vector<T>::Vector(const Vector<T>& other) : capacity_(other.capacity_), size_(other.size_), array_(allocate(capacity_))
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>::Vector(size_t size, default_init_t, const Alloc& alloc)
+    requires trivially_default_initializable<T>
+    : alloc_(alloc), capacity_(Growth::next_capacity(0, size, sizeof(T))), size_(size), array_(allocate(capacity_))
 {
-    for (size_t i = 0; i < size_; i++)
+}
+
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>::Vector(const Vector<T, Alloc, Growth>& other)
+    : alloc_(alloc_traits::select_on_container_copy_construction(other.alloc_)),
+      capacity_(other.capacity_),
+      size_(0),
+      array_(allocate(capacity_))
+{
+    try
     {
-        array_[i] = other.array_[i];
+        copy_construct(array_, other.array_, other.size_);
     }
+    catch (...)
+    {
+        deallocate(array_, capacity_);
+        throw;
+    }
+    size_ = other.size_;
 }
 
-template <typename T>
-Vector<T>::Vector(Vector<T>&& other) noexcept : capacity_(other.capacity_), size_(other.size_), array_(other.array_)
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>::Vector(Vector<T, Alloc, Growth>&& other) noexcept
+    : alloc_(std::move(other.alloc_)), capacity_(other.capacity_), size_(other.size_), array_(other.array_)
 {
     other.array_ = nullptr;
     other.size_ = 0;
     other.capacity_ = 0;
 }
 
-template <typename T>
-Vector<T>::Vector(std::initializer_list<T> init) 
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>::Vector(std::initializer_list<T> init, const Alloc& alloc) : alloc_(alloc)
 {
-    size_ = init.size();
-    capacity_ = geq_power_of_two(size_);
+    size_ = 0;
+    capacity_ = Growth::next_capacity(0, init.size(), sizeof(T));
     array_ = allocate(capacity_);
-    size_t i = 0;
-    for (auto it = init.begin(); it != init.end(); it++) {
-        new (array_ + i) T(*it);
-        i++;
+    try
+    {
+        copy_construct(array_, init.begin(), init.size());
     }
+    catch (...)
+    {
+        deallocate(array_, capacity_);
+        throw;
+    }
+    size_ = init.size();
 }
 
-template <typename T>
-T& Vector<T>::operator[](size_t index)
+template <typename T, typename Alloc, typename Growth>
+T& Vector<T, Alloc, Growth>::operator[](size_t index)
 {
     return array_[index];
 }
 
-template <typename T>
-const T& Vector<T>::operator[](size_t index) const
+template <typename T, typename Alloc, typename Growth>
+const T& Vector<T, Alloc, Growth>::operator[](size_t index) const
 {
     return array_[index];
 }
 
-template <typename T>
-Vector<T>& Vector<T>::push_back(const T& value)
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>& Vector<T, Alloc, Growth>::push_back(const T& value)
 {
-    if (size_ == capacity_)
-    {
-        size_t new_capacity = geq_power_of_two(size_ + 1);
-        T* new_array = allocate(new_capacity);
-        for (size_t i = 0; i < size_; i++)
-        {
-            new (new_array + i) T(std::move(array_[i]));
-            array_[i].~T();
-        }
-        delete reinterpret_cast<char*>(array_);
-        array_ = new_array;
-        capacity_ = new_capacity;
-    }
-    new (array_ + size_) T(value);
-    size_++;
+    emplace_back(value);
     return *this;
 }
 
-template <typename T>
-void Vector<T>::pop_back() 
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::pop_back()
 {
     if (empty()) throw std::runtime_error("Vector is empty");
-    array_[size_ - 1].~T();
+    alloc_traits::destroy(alloc_, array_ + size_ - 1);
     --size_;
 }
 
-template <typename T>
-bool Vector<T>::empty() const noexcept
+template <typename T, typename Alloc, typename Growth>
+bool Vector<T, Alloc, Growth>::empty() const noexcept
 {
     return size_ == 0;
 }
 
-template <typename T>
-bool Vector<T>::operator==(const Vector<T>& other) const
+template <typename T, typename Alloc, typename Growth>
+bool Vector<T, Alloc, Growth>::operator==(const Vector<T, Alloc, Growth>& other) const
 {
     if (size_ != other.size_) return false;
-    for (size_t i = 0; i < size_; ++i)
-    {
-        if (array_[i] != other.array_[i]) return false;
-    }
-    return true;
+    return simd::equal(array_, other.array_, size_);
 }
 
-template <typename T>
-bool Vector<T>::operator!=(const Vector<T>& other) const
+template <typename T, typename Alloc, typename Growth>
+bool Vector<T, Alloc, Growth>::operator!=(const Vector<T, Alloc, Growth>& other) const
 {
     return !(*this == other);
 }
 
-template <typename T>
-Vector<T>& Vector<T>::operator=(const Vector<T>& other)
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>& Vector<T, Alloc, Growth>::operator=(const Vector<T, Alloc, Growth>& other)
 {
     if (this != &other)
     {
         clear();
-        delete[] reinterpret_cast<char*>(array_);
+        deallocate(array_, capacity_);
+        array_ = nullptr;
+        capacity_ = 0;
 
-        capacity_ = other.capacity_;
-        size_ = other.size_;
-        array_ = allocate(capacity_);
-        for (size_t i = 0; i < size_; ++i)
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
         {
-    		new (array_ + i) T(other.array_[i]);
+            alloc_ = other.alloc_;
         }
+
+        array_ = allocate(other.capacity_);
+        capacity_ = other.capacity_;
+        copy_construct(array_, other.array_, other.size_);
+        size_ = other.size_;
     }
     return *this;
 }
 
-template <typename T>
-Vector<T>& Vector<T>::operator=(Vector<T>&& other) noexcept
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>& Vector<T, Alloc, Growth>::operator=(Vector<T, Alloc, Growth>&& other) noexcept(
+    std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value ||
+    std::allocator_traits<Alloc>::is_always_equal::value)
 {
     if (this != &other)
     {
         clear();
-        delete[] reinterpret_cast<char*>(array_);
+
+        if constexpr (!alloc_traits::propagate_on_container_move_assignment::value &&
+                      !alloc_traits::is_always_equal::value)
+        {
+            // memory owned by a different allocator cannot be adopted, move element by element instead
+            if (alloc_ != other.alloc_)
+            {
+                if (capacity_ < other.size_) reallocate(other.size_);
+                for (; size_ < other.size_; ++size_)
+                {
+                    alloc_traits::construct(alloc_, array_ + size_, std::move(other.array_[size_]));
+                }
+                other.clear();
+                return *this;
+            }
+        }
+
+        deallocate(array_, capacity_);
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+        {
+            alloc_ = std::move(other.alloc_);
+        }
 
         capacity_ = other.capacity_;
         size_ = other.size_;
@@ -283,118 +672,448 @@ Vector<T>& Vector<T>::operator=(Vector<T>&& other) noexcept
     return *this;
 }
 
-template <typename T>
-T& Vector<T>::front()
+template <typename T, typename Alloc, typename Growth>
+T& Vector<T, Alloc, Growth>::front()
 {
 	if (empty()) throw std::runtime_error("Vector is empty");
     return array_[0];
 }
 
-template <typename T>
-const T& Vector<T>::front() const
+template <typename T, typename Alloc, typename Growth>
+const T& Vector<T, Alloc, Growth>::front() const
 {
 	if (empty()) throw std::runtime_error("Vector is empty");
     return array_[0];
 }
 
-template <typename T>
-T& Vector<T>::back()
+template <typename T, typename Alloc, typename Growth>
+T& Vector<T, Alloc, Growth>::back()
 {
 	if (empty()) throw std::runtime_error("Vector is empty");
     return array_[size_ - 1];
 }
 
-template <typename T>
-const T& Vector<T>::back() const
+template <typename T, typename Alloc, typename Growth>
+const T& Vector<T, Alloc, Growth>::back() const
 {
 	if (empty()) throw std::runtime_error("Vector is empty");
     return array_[size_ - 1];
 }
 
-template <typename T>
-T& Vector<T>::at(size_t index)
+template <typename T, typename Alloc, typename Growth>
+T& Vector<T, Alloc, Growth>::at(size_t index)
 {
     if (index >= size_) throw std::out_of_range("Index out of range");
     return array_[index];
 }
 
-template <typename T>
-const T& Vector<T>::at(size_t index) const
+template <typename T, typename Alloc, typename Growth>
+const T& Vector<T, Alloc, Growth>::at(size_t index) const
 {
     if (index >= size_) throw std::out_of_range("Index out of range");
     return array_[index];
 }
 
-template <typename T>
-T* Vector<T>::data()
+template <typename T, typename Alloc, typename Growth>
+T* Vector<T, Alloc, Growth>::data()
 {
     return array_;
 }
-template <typename T>
+template <typename T, typename Alloc, typename Growth>
 
-const T* Vector<T>::data() const noexcept 
-{ 
-	return array_; 
+const T* Vector<T, Alloc, Growth>::data() const noexcept
+{
+	return array_;
 }
 
-template <typename T>
-void Vector<T>::reserve(size_t new_capacity) {
-    if (new_capacity <= capacity_) return;
-    
-    T* new_array = allocate(new_capacity);
-    for (size_t i = 0; i < size_; i++) {
-        new (new_array + i) T(std::move(array_[i]));
-        array_[i].~T();
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::fill(const T& value)
+{
+    simd::fill(array_, size_, value);
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::find(const T& value)
+{
+    return array_ + simd::find(static_cast<const T*>(array_), size_, value);
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::const_iterator Vector<T, Alloc, Growth>::find(const T& value) const
+{
+    return array_ + simd::find(static_cast<const T*>(array_), size_, value);
+}
+
+template <typename T, typename Alloc, typename Growth>
+size_t Vector<T, Alloc, Growth>::count(const T& value) const
+{
+    return simd::count(static_cast<const T*>(array_), size_, value);
+}
+
+template <typename T, typename Alloc, typename Growth>
+T Vector<T, Alloc, Growth>::min() const
+{
+    if (empty()) throw std::runtime_error("Vector is empty");
+    return simd::min(static_cast<const T*>(array_), size_);
+}
+
+template <typename T, typename Alloc, typename Growth>
+T Vector<T, Alloc, Growth>::max() const
+{
+    if (empty()) throw std::runtime_error("Vector is empty");
+    return simd::max(static_cast<const T*>(array_), size_);
+}
+
+template <typename T, typename Alloc, typename Growth>
+template <typename Policy, typename ConstructChunk>
+void Vector<T, Alloc, Growth>::build(Policy&& policy, size_t count, ConstructChunk construct)
+{
+    size_t capacity = Growth::next_capacity(0, count, sizeof(T));
+    T* array = allocate(capacity);
+
+    std::mutex failed_mutex;
+    std::vector<std::pair<size_t, size_t>> failed;
+    try
+    {
+        exec::for_each_chunk(policy, count, parallel_grain,
+                             [&](size_t begin, size_t end)
+                             {
+                                 try
+                                 {
+                                     construct(array + begin, begin, end);
+                                 }
+                                 catch (...)
+                                 {
+                                     std::lock_guard<std::mutex> lock(failed_mutex);
+                                     failed.emplace_back(begin, end);
+                                     throw;
+                                 }
+                             });
     }
-    delete[] reinterpret_cast<char*>(array_);
-    array_ = new_array;
-    capacity_ = new_capacity;
+    catch (...)
+    {
+        // every chunk has run; the ones that threw already cleaned up after themselves
+        std::sort(failed.begin(), failed.end());
+        size_t built = 0;
+        for (const auto& [begin, end] : failed)
+        {
+            destroy_n(array + built, begin - built);
+            built = end;
+        }
+        destroy_n(array + built, count - built);
+        deallocate(array, capacity);
+        throw;
+    }
+
+    clear();
+    deallocate(array_, capacity_);
+    array_ = array;
+    capacity_ = capacity;
+    size_ = count;
 }
 
-template <typename T>
-void Vector<T>::shrink_to_fit() {
+template <typename T, typename Alloc, typename Growth>
+template <exec::execution_policy Policy, std::random_access_iterator It>
+void Vector<T, Alloc, Growth>::copy_from(Policy&& policy, It first, It last)
+{
+    build(policy, static_cast<size_t>(last - first),
+          [&](T* to, size_t begin, size_t end) { copy_construct(to, first + begin, end - begin); });
+}
+
+template <typename T, typename Alloc, typename Growth>
+template <exec::execution_policy Policy, std::random_access_iterator It, typename UnaryOp>
+void Vector<T, Alloc, Growth>::transform(Policy&& policy, It first, It last, UnaryOp op)
+{
+    build(policy, static_cast<size_t>(last - first),
+          [&](T* to, size_t begin, size_t end)
+          {
+              size_t i = 0;
+              try
+              {
+                  for (; begin + i < end; ++i)
+                  {
+                      alloc_traits::construct(alloc_, to + i, op(first[begin + i]));
+                  }
+              }
+              catch (...)
+              {
+                  destroy_n(to, i);
+                  throw;
+              }
+          });
+}
+
+template <typename T, typename Alloc, typename Growth>
+template <exec::execution_policy Policy>
+void Vector<T, Alloc, Growth>::fill(Policy&& policy, const T& value)
+{
+    T copy(value);
+    exec::for_each_chunk(policy, size_, parallel_grain,
+                         [&](size_t begin, size_t end) { simd::fill(array_ + begin, end - begin, copy); });
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::reserve(size_t new_capacity) {
+    if (new_capacity <= capacity_) return;
+    reallocate(new_capacity);
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::shrink_to_fit() {
     if (capacity_ == size_) return;
-    
-    T* new_array = allocate(size_);
-    for (size_t i = 0; i < size_; i++) {
-        new (new_array + i) T(std::move(array_[i]));
-        array_[i].~T();
-    }
-    delete[] reinterpret_cast<char*>(array_);
-    array_ = new_array;
-    capacity_ = size_;
+    reallocate(size_);
 }
 
-template <typename T>
-void Vector<T>::swap(Vector<T>& other) noexcept
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::swap(Vector<T, Alloc, Growth>& other) noexcept
 {
+    if constexpr (alloc_traits::propagate_on_container_swap::value)
+    {
+        std::swap(alloc_, other.alloc_);
+    }
     std::swap(size_, other.size_);
     std::swap(capacity_, other.capacity_);
     std::swap(array_, other.array_);
 }
 
-template <typename T>
+template <typename T, typename Alloc, typename Growth>
 template <typename... Args>
-T& Vector<T>::emplace_back(Args&&... args)
+T& Vector<T, Alloc, Growth>::emplace_back(Args&&... args)
 {
+    if constexpr (reallocates_in_place)
+    {
+        if (size_ == capacity_)
+        {
+            // args may refer to an element of this vector, which realloc can move
+            T value(std::forward<Args>(args)...);
+            reallocate(grow_capacity(size_ + 1));
+            alloc_traits::construct(alloc_, array_ + size_, std::move(value));
+            size_++;
+            return array_[size_ - 1];
+        }
+    }
+
     if (size_ == capacity_)
     {
-        size_t newCapacity = geq_power_of_two(size_ + 1);
+        // construct the new element first: args may refer to an element of this vector
+        size_t newCapacity = grow_capacity(size_ + 1);
         T* new_array = allocate(newCapacity);
+        try
+        {
+            alloc_traits::construct(alloc_, new_array + size_, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            deallocate(new_array, newCapacity);
+            throw;
+        }
 
-        for (size_t i = 0; i < size_; i++)
+        try
+        {
+            relocate(array_, size_, new_array);
+        }
+        catch (...)
         {
-            new (new_array + i) T(std::move(array_[i]));
-            array_[i].~T();
+            alloc_traits::destroy(alloc_, new_array + size_);
+            deallocate(new_array, newCapacity);
+            throw;
         }
 
-        delete[] reinterpret_cast<char*>(array_);
+        deallocate(array_, capacity_);
 
         array_ = new_array;
         capacity_ = newCapacity;
     }
-    new (array_ + size_) T(std::forward<Args>(args)...);
+    else
+    {
+        alloc_traits::construct(alloc_, array_ + size_, std::forward<Args>(args)...);
+    }
     size_++;
 
     return array_[size_ - 1];
-}
\ No newline at end of file
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::begin() noexcept
+{
+    return array_;
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::const_iterator Vector<T, Alloc, Growth>::begin() const noexcept
+{
+    return array_;
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::end() noexcept
+{
+    return array_ + size_;
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::const_iterator Vector<T, Alloc, Growth>::end() const noexcept
+{
+    return array_ + size_;
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::const_iterator Vector<T, Alloc, Growth>::cbegin() const noexcept
+{
+    return array_;
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::const_iterator Vector<T, Alloc, Growth>::cend() const noexcept
+{
+    return array_ + size_;
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::resize(size_t count)
+{
+    if (count <= size_)
+    {
+        delete_array(count, size_);
+        size_ = count;
+        return;
+    }
+    if (count > capacity_) reallocate(grow_capacity(count));
+    init_default(size_, count);
+    size_ = count;
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::resize_uninitialized(size_t count)
+    requires trivially_default_initializable<T>
+{
+    if (count > capacity_) reallocate(grow_capacity(count));
+    size_ = count;
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::resize(size_t count, const T& value)
+{
+    if (count <= size_)
+    {
+        delete_array(count, size_);
+        size_ = count;
+        return;
+    }
+    insert(end(), count - size_, value);
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::assign(size_t count, const T& value)
+{
+    T copy(value);
+    clear();
+    if (count > capacity_)
+    {
+        deallocate(array_, capacity_);
+        array_ = nullptr;
+        capacity_ = 0;
+        array_ = allocate(count);
+        capacity_ = count;
+    }
+    fill_construct(array_, count, copy);
+    size_ = count;
+}
+
+template <typename T, typename Alloc, typename Growth>
+template <std::input_iterator InputIt>
+void Vector<T, Alloc, Growth>::assign(InputIt first, InputIt last)
+{
+    clear();
+    if constexpr (std::forward_iterator<InputIt>)
+    {
+        size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count > capacity_)
+        {
+            deallocate(array_, capacity_);
+            array_ = nullptr;
+            capacity_ = 0;
+            array_ = allocate(count);
+            capacity_ = count;
+        }
+        copy_construct(array_, first, count);
+        size_ = count;
+    }
+    else
+    {
+        for (; first != last; ++first) emplace_back(*first);
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::assign(std::initializer_list<T> init)
+{
+    assign(init.begin(), init.end());
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::insert(const_iterator pos, const T& value)
+{
+    return insert(pos, 1, value);
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::insert(const_iterator pos, size_t count,
+                                                                             const T& value)
+{
+    // value may live in this vector and be moved by the insertion
+    T copy(value);
+    return insert_n(static_cast<size_t>(pos - array_), count, [&](T* gap) { fill_construct(gap, count, copy); });
+}
+
+template <typename T, typename Alloc, typename Growth>
+template <std::input_iterator InputIt>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::insert(const_iterator pos, InputIt first,
+                                                                             InputIt last)
+{
+    size_t index = static_cast<size_t>(pos - array_);
+    if constexpr (std::forward_iterator<InputIt>)
+    {
+        size_t count = static_cast<size_t>(std::distance(first, last));
+        return insert_n(index, count, [&](T* gap) { copy_construct(gap, first, count); });
+    }
+    else
+    {
+        // single pass: the length is unknown, so append and rotate into place
+        size_t old_size = size_;
+        for (; first != last; ++first) emplace_back(*first);
+        std::rotate(array_ + index, array_ + old_size, array_ + size_);
+        return array_ + index;
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::insert(const_iterator pos,
+                                                                             std::initializer_list<T> init)
+{
+    return insert(pos, init.begin(), init.end());
+}
+
+template <typename T, typename Alloc, typename Growth>
+template <std::input_iterator InputIt>
+void Vector<T, Alloc, Growth>::append(InputIt first, InputIt last)
+{
+    insert(cend(), first, last);
+}
+
+template <typename T, typename Alloc, typename Growth>
+template <std::ranges::input_range Range>
+void Vector<T, Alloc, Growth>::append(Range&& range)
+{
+    if constexpr (std::ranges::forward_range<Range> && std::ranges::sized_range<Range>)
+    {
+        size_t count = static_cast<size_t>(std::ranges::size(range));
+        insert_n(size_, count, [&](T* gap) { copy_construct(gap, std::ranges::begin(range), count); });
+    }
+    else
+    {
+        auto first = std::ranges::begin(range);
+        auto last = std::ranges::end(range);
+        for (; first != last; ++first) emplace_back(*first);
+    }
+}
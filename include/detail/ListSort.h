@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+// Stable merge sort over null-terminated singly linked chains, shared by List and ForwardList.
+// Node is any type with a Node* next link; value(node) returns the element comp looks at.
+// Nothing is allocated and no element is moved: only next links are rewritten.
+namespace detail
+{
+// merge the sorted chain right into the sorted chain left, stably; left receives every node
+// of both chains even if comp throws
+template <typename Node, typename Value, typename Compare>
+void merge_runs(Node*& left, Node* right, Value value, Compare& comp)
+{
+    Node* merged = nullptr;
+    Node** link = &merged;
+    Node* rest = left;
+    try
+    {
+        while (rest && right)
+        {
+            // take from the right only when strictly smaller, so equal elements keep their order
+            if (comp(value(right), value(rest)))
+            {
+                *link = right;
+                right = right->next;
+            }
+            else
+            {
+                *link = rest;
+                rest = rest->next;
+            }
+            link = &(*link)->next;
+        }
+    }
+    catch (...)
+    {
+        *link = rest;
+        while (*link) link = &(*link)->next;
+        *link = right;
+        left = merged;
+        throw;
+    }
+    *link = rest ? rest : right;
+    left = merged;
+}
+
+// sort chain in place; if comp throws, chain still holds every node, in no particular order
+template <typename Node, typename Value, typename Compare>
+void sort_chain(Node*& chain, Value value, Compare& comp)
+{
+    if (!chain || !chain->next) return;
+
+    // bins[i] is empty or a sorted run of 2^i nodes, all older than the runs below it;
+    // nodes are added one at a time and carried upwards like a binary counter
+    Node* bins[64] = {};
+    std::size_t filled = 0;
+    Node* unsorted = std::exchange(chain, nullptr);
+    Node* run = nullptr;
+    try
+    {
+        while (unsorted)
+        {
+            run = unsorted;
+            unsorted = unsorted->next;
+            run->next = nullptr;
+
+            std::size_t i = 0;
+            for (; i < filled && bins[i]; ++i)
+            {
+                merge_runs(bins[i], std::exchange(run, nullptr), value, comp);
+                run = std::exchange(bins[i], nullptr);
+            }
+            if (i == filled) ++filled;
+            bins[i] = std::exchange(run, nullptr);
+        }
+
+        for (std::size_t i = 0; i < filled; ++i)
+        {
+            if (!bins[i]) continue;
+            merge_runs(bins[i], std::exchange(run, nullptr), value, comp);
+            run = std::exchange(bins[i], nullptr);
+        }
+    }
+    catch (...)
+    {
+        // keep every node: chain whatever is left together
+        Node* rest = unsorted;
+        for (Node* piece : bins)
+        {
+            if (!piece) continue;
+            Node* last = piece;
+            while (last->next) last = last->next;
+            last->next = rest;
+            rest = piece;
+        }
+        if (run)
+        {
+            Node* last = run;
+            while (last->next) last = last->next;
+            last->next = rest;
+            rest = run;
+        }
+        chain = rest;
+        throw;
+    }
+    chain = run;
+}
+}  // namespace detail
@@ -0,0 +1,124 @@
+#include "../include/HazardPointer.h"
+
+namespace
+{
+// retired objects tolerated per slot before a scan: each scan then frees at least half of
+// what it looks at, since at most one object per slot can be protected
+constexpr std::size_t scan_factor = 2;
+// floor for the scan threshold, so a domain with one or two slots does not scan on every retire
+constexpr std::size_t min_scan = 16;
+}  // namespace
+
+HazardDomain::HazardDomain(Reclaimer reclaim, void* context) noexcept
+    : slots_(nullptr), slot_count_(0), retired_(nullptr), retired_count_(0), reclaim_(reclaim), context_(context)
+{
+}
+
+HazardDomain::~HazardDomain()
+{
+    Retired* object = retired_.load(std::memory_order_acquire);
+    while (object)
+    {
+        Retired* next = object->next_retired;
+        reclaim_(object, context_);
+        object = next;
+    }
+
+    Slot* slot = slots_.load(std::memory_order_acquire);
+    while (slot)
+    {
+        Slot* next = slot->next;
+        delete slot;
+        slot = next;
+    }
+}
+
+HazardDomain::Slot* HazardDomain::acquire_slot()
+{
+    for (Slot* slot = slots_.load(std::memory_order_acquire); slot; slot = slot->next)
+    {
+        bool expected = false;
+        if (!slot->active.load(std::memory_order_relaxed) &&
+            slot->active.compare_exchange_strong(expected, true, std::memory_order_acquire))
+        {
+            return slot;
+        }
+    }
+
+    // every slot is taken: add one, which starts out active
+    Slot* slot = new Slot;
+    Slot* head = slots_.load(std::memory_order_relaxed);
+    do
+    {
+        slot->next = head;
+    } while (!slots_.compare_exchange_weak(head, slot, std::memory_order_release, std::memory_order_relaxed));
+    slot_count_.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+bool HazardDomain::is_hazard(const void* object) const noexcept
+{
+    for (Slot* slot = slots_.load(std::memory_order_acquire); slot; slot = slot->next)
+    {
+        if (slot->hazard.load(std::memory_order_seq_cst) == object) return true;
+    }
+    return false;
+}
+
+void HazardDomain::push_retired(Retired* first, Retired* last) noexcept
+{
+    Retired* head = retired_.load(std::memory_order_relaxed);
+    do
+    {
+        last->next_retired = head;
+    } while (!retired_.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void HazardDomain::retire(Retired* object) noexcept
+{
+    push_retired(object, object);
+
+    std::size_t threshold = scan_factor * slot_count_.load(std::memory_order_relaxed);
+    if (threshold < min_scan) threshold = min_scan;
+    if (retired_count_.fetch_add(1, std::memory_order_relaxed) + 1 >= threshold) scan();
+}
+
+void HazardDomain::scan() noexcept
+{
+    // objects retired while the scan runs start a fresh list and wait for the next one
+    Retired* object = retired_.exchange(nullptr, std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    Retired* kept = nullptr;
+    Retired* kept_last = nullptr;
+    std::size_t reclaimed = 0;
+    while (object)
+    {
+        Retired* next = object->next_retired;
+        if (is_hazard(object))
+        {
+            object->next_retired = kept;
+            kept = object;
+            if (!kept_last) kept_last = object;
+        }
+        else
+        {
+            reclaim_(object, context_);
+            ++reclaimed;
+        }
+        object = next;
+    }
+
+    if (kept) push_retired(kept, kept_last);
+    retired_count_.fetch_sub(reclaimed, std::memory_order_relaxed);
+}
+
+HazardPointer::HazardPointer(HazardDomain& domain) : slot_(domain.acquire_slot()) {}
+
+HazardPointer::~HazardPointer()
+{
+    slot_->hazard.store(nullptr, std::memory_order_release);
+    slot_->active.store(false, std::memory_order_release);
+}
+
+void HazardPointer::reset() noexcept { slot_->hazard.store(nullptr, std::memory_order_release); }
@@ -0,0 +1,117 @@
+#include "../include/MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+namespace
+{
+[[noreturn]] void throw_errno(const char* what) { throw std::system_error(errno, std::generic_category(), what); }
+}  // namespace
+
+MappedFile::MappedFile(const std::string& path) : fd_(-1), data_(nullptr), size_(0)
+{
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd_ < 0) throw_errno("open");
+
+    struct stat status;
+    if (::fstat(fd_, &status) != 0)
+    {
+        int error = errno;
+        ::close(fd_);
+        throw std::system_error(error, std::generic_category(), "fstat");
+    }
+
+    size_ = static_cast<std::size_t>(status.st_size);
+    if (size_ == 0) return;
+
+    data_ = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (data_ == MAP_FAILED)
+    {
+        int error = errno;
+        ::close(fd_);
+        throw std::system_error(error, std::generic_category(), "mmap");
+    }
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : fd_(std::exchange(other.fd_, -1)),
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    MappedFile(std::move(other)).swap(*this);
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    unmap();
+    if (fd_ >= 0) ::close(fd_);
+}
+
+void MappedFile::unmap() noexcept
+{
+    if (data_) ::munmap(data_, size_);
+    data_ = nullptr;
+}
+
+void* MappedFile::data() const noexcept { return data_; }
+
+std::size_t MappedFile::size() const noexcept { return size_; }
+
+void MappedFile::resize(std::size_t bytes)
+{
+    if (bytes == size_) return;
+
+    // shrink the mapping before the file so no mapped page lies past the end of the file
+    if (bytes < size_)
+    {
+        if (bytes == 0)
+        {
+            unmap();
+        }
+        else
+        {
+            void* data = ::mremap(data_, size_, bytes, MREMAP_MAYMOVE);
+            if (data == MAP_FAILED) throw_errno("mremap");
+            data_ = data;
+        }
+        size_ = bytes;
+        if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) throw_errno("ftruncate");
+        return;
+    }
+
+    if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) throw_errno("ftruncate");
+    void* data = data_ ? ::mremap(data_, size_, bytes, MREMAP_MAYMOVE)
+                       : ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (data == MAP_FAILED)
+    {
+        int error = errno;
+        // best effort: give the file back the length the old mapping covers
+        [[maybe_unused]] int restored = ::ftruncate(fd_, static_cast<off_t>(size_));
+        throw std::system_error(error, std::generic_category(), data_ ? "mremap" : "mmap");
+    }
+    data_ = data;
+    size_ = bytes;
+}
+
+void MappedFile::sync()
+{
+    if (data_ && ::msync(data_, size_, MS_SYNC) != 0) throw_errno("msync");
+}
+
+void MappedFile::swap(MappedFile& other) noexcept
+{
+    std::swap(fd_, other.fd_);
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+}
@@ -0,0 +1,83 @@
+#include "../include/MonotonicArena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+MonotonicArena::MonotonicArena(std::size_t initial_size)
+    : head_(nullptr),
+      cursor_(nullptr),
+      end_(nullptr),
+      initial_size_(std::max<std::size_t>(initial_size, 64)),
+      next_block_size_(initial_size_),
+      bytes_used_(0)
+{
+}
+
+MonotonicArena::~MonotonicArena()
+{
+    while (head_)
+    {
+        Block* next = head_->next;
+        ::operator delete(head_);
+        head_ = next;
+    }
+}
+
+void MonotonicArena::add_block(std::size_t min_bytes)
+{
+    std::size_t size = std::max(next_block_size_, min_bytes + sizeof(Block));
+    Block* block = static_cast<Block*>(::operator new(size));
+    block->next = head_;
+    block->size = size;
+    head_ = block;
+    cursor_ = reinterpret_cast<char*>(block + 1);
+    end_ = reinterpret_cast<char*>(block) + size;
+    next_block_size_ = size * 2;
+}
+
+void* MonotonicArena::allocate(std::size_t bytes, std::size_t alignment)
+{
+    auto align_up = [alignment](char* pointer)
+    {
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(pointer);
+        return reinterpret_cast<char*>((address + alignment - 1) & ~(alignment - 1));
+    };
+
+    char* result = cursor_ ? align_up(cursor_) : nullptr;
+    if (!result || result > end_ || static_cast<std::size_t>(end_ - result) < bytes)
+    {
+        add_block(bytes + alignment);
+        result = align_up(cursor_);
+    }
+    cursor_ = result + bytes;
+    bytes_used_ += bytes;
+    return result;
+}
+
+void MonotonicArena::deallocate(void* pointer, std::size_t bytes) noexcept
+{
+    if (static_cast<char*>(pointer) + bytes == cursor_)
+    {
+        cursor_ = static_cast<char*>(pointer);
+        bytes_used_ -= bytes;
+    }
+}
+
+void MonotonicArena::release() noexcept
+{
+    if (!head_) return;
+
+    // blocks are pushed to the front, so the first (smallest) block is at the tail
+    while (head_->next)
+    {
+        Block* next = head_->next;
+        ::operator delete(head_);
+        head_ = next;
+    }
+    cursor_ = reinterpret_cast<char*>(head_ + 1);
+    end_ = reinterpret_cast<char*>(head_) + head_->size;
+    next_block_size_ = head_->size * 2;
+    bytes_used_ = 0;
+}
+
+std::size_t MonotonicArena::bytes_used() const noexcept { return bytes_used_; }
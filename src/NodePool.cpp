@@ -0,0 +1,220 @@
+#include "../include/NodePool.h"
+
+#include <mutex>
+
+namespace
+{
+constexpr std::size_t class_count = NodePool::max_block / NodePool::granularity;
+// blocks a thread cache exchanges with the depot at a time
+constexpr std::size_t batch_size = 32;
+
+// every size class holds at least two pointers
+struct Block
+{
+    Block* next;
+    Block* next_batch;
+};
+
+// Shared by all threads. Allocated once and never destroyed, so it is still usable
+// while thread_local destructors run at process exit.
+struct Depot
+{
+    std::mutex mutex;
+    Block* batches[class_count] = {};
+    // carves blocks that have never been handed out; its slabs are never released
+    NodePool carver;
+};
+
+Depot& depot()
+{
+    static Depot* instance = new Depot;
+    return *instance;
+}
+
+// Trivially destructible, so it stays usable for nodes freed by thread_local
+// containers destroyed after the flush below; from then on it bypasses the cache.
+struct ThreadCache
+{
+    Block* lists[class_count];
+    std::size_t counts[class_count];
+    bool flushed;
+};
+
+thread_local ThreadCache cache;
+
+void give_back(std::size_t index, std::size_t limit)
+{
+    Block* batch = cache.lists[index];
+    Block* last = batch;
+    std::size_t taken = 1;
+    for (; taken < limit && last->next; ++taken) last = last->next;
+    cache.lists[index] = last->next;
+    cache.counts[index] -= taken;
+    last->next = nullptr;
+
+    Depot& shared = depot();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    batch->next_batch = shared.batches[index];
+    shared.batches[index] = batch;
+}
+
+void take(std::size_t index)
+{
+    Depot& shared = depot();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    if (Block* batch = shared.batches[index])
+    {
+        shared.batches[index] = batch->next_batch;
+        std::size_t count = 0;
+        for (Block* block = batch; block; block = block->next) ++count;
+        cache.lists[index] = batch;
+        cache.counts[index] = count;
+        return;
+    }
+
+    std::size_t size = (index + 1) * NodePool::granularity;
+    for (std::size_t i = 0; i < batch_size; ++i)
+    {
+        Block* block = static_cast<Block*>(shared.carver.allocate(size));
+        block->next = cache.lists[index];
+        cache.lists[index] = block;
+        ++cache.counts[index];
+    }
+}
+
+// returns the thread's cached blocks to the depot when the thread exits
+struct CacheFlusher
+{
+    ~CacheFlusher()
+    {
+        for (std::size_t index = 0; index < class_count; ++index)
+        {
+            while (cache.lists[index]) give_back(index, batch_size);
+        }
+        cache.flushed = true;
+    }
+};
+
+void ensure_flusher()
+{
+    thread_local CacheFlusher flusher;
+}
+}  // namespace
+
+NodePool::NodePool() noexcept : free_(), slabs_(nullptr), cursor_(nullptr), end_(nullptr), slab_count_(0) {}
+
+NodePool::~NodePool() { release(); }
+
+std::size_t NodePool::size_class(std::size_t bytes) noexcept
+{
+    if (bytes == 0) bytes = 1;
+    return (bytes + granularity - 1) / granularity - 1;
+}
+
+void NodePool::add_slab()
+{
+    Slab* slab = static_cast<Slab*>(::operator new(slab_size));
+    slab->next = slabs_;
+    slabs_ = slab;
+    cursor_ = reinterpret_cast<char*>(slab + 1);
+    end_ = reinterpret_cast<char*>(slab) + slab_size;
+    ++slab_count_;
+}
+
+void* NodePool::allocate(std::size_t bytes)
+{
+    if (bytes > max_block) return ::operator new(bytes);
+
+    std::size_t index = size_class(bytes);
+    if (FreeBlock* block = free_[index])
+    {
+        free_[index] = block->next;
+        return block;
+    }
+
+    // the tail of the current slab is too short for this class; it stays unused
+    std::size_t size = (index + 1) * granularity;
+    if (static_cast<std::size_t>(end_ - cursor_) < size) add_slab();
+    void* result = cursor_;
+    cursor_ += size;
+    return result;
+}
+
+void NodePool::deallocate(void* pointer, std::size_t bytes) noexcept
+{
+    if (!pointer) return;
+    if (bytes > max_block)
+    {
+        ::operator delete(pointer);
+        return;
+    }
+
+    FreeBlock* block = static_cast<FreeBlock*>(pointer);
+    std::size_t index = size_class(bytes);
+    block->next = free_[index];
+    free_[index] = block;
+}
+
+void NodePool::release() noexcept
+{
+    while (slabs_)
+    {
+        Slab* next = slabs_->next;
+        ::operator delete(slabs_);
+        slabs_ = next;
+    }
+    for (FreeBlock*& list : free_) list = nullptr;
+    cursor_ = end_ = nullptr;
+    slab_count_ = 0;
+}
+
+std::size_t NodePool::slab_count() const noexcept { return slab_count_; }
+
+void* NodePool::allocate_shared(std::size_t bytes)
+{
+    if (bytes > max_block) return ::operator new(bytes);
+
+    std::size_t index = size_class(bytes);
+    if (cache.flushed)
+    {
+        Depot& shared = depot();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        return shared.carver.allocate(bytes);
+    }
+    if (!cache.lists[index])
+    {
+        ensure_flusher();
+        take(index);
+    }
+    Block* block = cache.lists[index];
+    cache.lists[index] = block->next;
+    --cache.counts[index];
+    return block;
+}
+
+void NodePool::deallocate_shared(void* pointer, std::size_t bytes) noexcept
+{
+    if (!pointer) return;
+    if (bytes > max_block)
+    {
+        ::operator delete(pointer);
+        return;
+    }
+
+    std::size_t index = size_class(bytes);
+    if (cache.flushed)
+    {
+        Depot& shared = depot();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        shared.carver.deallocate(pointer, bytes);
+        return;
+    }
+
+    ensure_flusher();
+    Block* block = static_cast<Block*>(pointer);
+    block->next = cache.lists[index];
+    cache.lists[index] = block;
+    // keep the cache bounded so a thread that only frees (a queue consumer) hands
+    // blocks back to the threads that allocate
+    if (++cache.counts[index] > 2 * batch_size) give_back(index, batch_size);
+}
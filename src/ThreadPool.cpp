@@ -0,0 +1,134 @@
+#include "../include/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace
+{
+// Shared by the caller of parallel_for and the helper tasks it queues. Helpers
+// that only start after every chunk is taken find nothing to do, which is why
+// the state is reference counted rather than living on the caller's stack.
+struct ParallelFor
+{
+    const std::function<void(std::size_t, std::size_t)>* body;
+    std::size_t count;
+    std::size_t chunks;
+    std::atomic<std::size_t> next{0};
+
+    std::mutex mutex;
+    std::condition_variable done;
+    std::size_t finished = 0;
+    std::exception_ptr error;
+
+    void run()
+    {
+        for (std::size_t chunk; (chunk = next.fetch_add(1)) < chunks;)
+        {
+            std::exception_ptr failure;
+            try
+            {
+                (*body)(begin(chunk), begin(chunk + 1));
+            }
+            catch (...)
+            {
+                failure = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (failure && !error) error = failure;
+            if (++finished == chunks) done.notify_all();
+        }
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return finished == chunks; });
+    }
+
+    // the first count % chunks chunks take one extra index
+    std::size_t begin(std::size_t chunk) const
+    {
+        return chunk * (count / chunks) + std::min(chunk, count % chunks);
+    }
+};
+}  // namespace
+
+ThreadPool::ThreadPool(std::size_t threads) : stopping_(false)
+{
+    workers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i)
+    {
+        workers_.emplace_back([this] { work(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    ready_.notify_all();
+    for (std::thread& worker : workers_) worker.join();
+}
+
+std::size_t ThreadPool::size() const noexcept { return workers_.size(); }
+
+void ThreadPool::work()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) return;
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    ready_.notify_one();
+}
+
+void ThreadPool::parallel_for(std::size_t count, std::size_t grain,
+                              const std::function<void(std::size_t, std::size_t)>& body)
+{
+    if (count == 0) return;
+    grain = std::max<std::size_t>(grain, 1);
+    std::size_t chunks = std::min(count / grain + (count % grain != 0), workers_.size() + 1);
+    if (chunks == 1)
+    {
+        body(0, count);
+        return;
+    }
+
+    auto state = std::make_shared<ParallelFor>();
+    state->body = &body;
+    state->count = count;
+    state->chunks = chunks;
+    for (std::size_t i = 1; i < chunks; ++i)
+    {
+        submit([state] { state->run(); });
+    }
+    state->run();
+    state->wait();
+    if (state->error) std::rethrow_exception(state->error);
+}
+
+ThreadPool& ThreadPool::shared()
+{
+    static ThreadPool pool(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+    return pool;
+}